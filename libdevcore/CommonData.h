@@ -280,6 +280,7 @@ void iterateReplacing(std::vector<T>& _vector, F const& _f)
 		{
 			if (!useModified)
 			{
+				modifiedVector.reserve(_vector.size());
 				std::move(_vector.begin(), _vector.begin() + i, back_inserter(modifiedVector));
 				useModified = true;
 			}
@@ -308,6 +309,7 @@ void iterateReplacingWindow(std::vector<T>& _vector, F const& _f, std::index_seq
 		{
 			if (!useModified)
 			{
+				modifiedVector.reserve(_vector.size());
 				std::move(_vector.begin(), _vector.begin() + i, back_inserter(modifiedVector));
 				useModified = true;
 			}
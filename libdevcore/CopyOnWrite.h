@@ -0,0 +1,63 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>
+
+namespace dev
+{
+
+/**
+ * Value wrapper whose copies share the wrapped value until one of them is modified.
+ * Copying is constant time, the first modification after a copy clones the value.
+ * Read access goes through operator* and operator->, write access through write().
+ * Not thread-safe: copies sharing a value must not be modified concurrently.
+ */
+template <class T>
+class CopyOnWrite
+{
+public:
+	CopyOnWrite(): m_value(std::make_shared<T>()) {}
+	explicit CopyOnWrite(T _value): m_value(std::make_shared<T>(std::move(_value))) {}
+
+	T const& operator*() const { return *m_value; }
+	T const* operator->() const { return m_value.get(); }
+
+	/// @returns a reference to the value that is not shared with any other copy.
+	T& write()
+	{
+		if (m_value.use_count() > 1)
+			m_value = std::make_shared<T>(*m_value);
+		return *m_value;
+	}
+
+	/// @returns true if this and @a _other share their value, i.e. neither has been
+	/// modified since one was copied from the other.
+	bool sharesValueWith(CopyOnWrite const& _other) const { return m_value == _other.m_value; }
+
+	bool operator==(CopyOnWrite const& _other) const
+	{
+		return m_value == _other.m_value || *m_value == *_other.m_value;
+	}
+	bool operator!=(CopyOnWrite const& _other) const { return !(*this == _other); }
+
+private:
+	std::shared_ptr<T> m_value;
+};
+
+}
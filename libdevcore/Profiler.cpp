@@ -0,0 +1,150 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Collection of time, allocation and memory statistics per compiler phase.
+ */
+
+#include <libdevcore/Profiler.h>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace dev;
+
+namespace
+{
+/// Constant-initialised, so it can be used by allocations during static initialisation.
+thread_local uint64_t t_allocations = 0;
+}
+
+Profiler& Profiler::instance()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+void Profiler::countAllocation() noexcept
+{
+	++t_allocations;
+}
+
+void Profiler::reset()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_phases.clear();
+}
+
+void Profiler::record(
+	string const& _phase,
+	chrono::nanoseconds _wallTime,
+	ResourceUsage const& _start,
+	ResourceUsage const& _end
+)
+{
+	lock_guard<mutex> lock(m_mutex);
+	Phase& phase = m_phases[_phase];
+	phase.calls++;
+	phase.wallTime += _wallTime;
+	phase.cpuTime += _end.cpuTime - _start.cpuTime;
+	phase.minorPageFaults += _end.minorPageFaults - _start.minorPageFaults;
+	phase.peakRSSGrowth += _end.peakRSS - _start.peakRSS;
+	phase.allocations += _end.allocations - _start.allocations;
+}
+
+Json::Value Profiler::report() const
+{
+	Json::Value result{Json::objectValue};
+	if (uint64_t peakRSS = peakResidentSetSize())
+		result["peakRSSKb"] = Json::UInt64(peakRSS);
+	result["phases"] = Json::objectValue;
+	lock_guard<mutex> lock(m_mutex);
+	for (auto const& [name, phase]: m_phases)
+	{
+		Json::Value& entry = result["phases"][name];
+		entry["calls"] = Json::UInt64(phase.calls);
+		entry["wallTimeMs"] = chrono::duration<double, milli>(phase.wallTime).count();
+		entry["cpuTimeMs"] = chrono::duration<double, milli>(phase.cpuTime).count();
+		entry["minorPageFaults"] = Json::UInt64(phase.minorPageFaults);
+		entry["peakRSSGrowthKb"] = Json::UInt64(phase.peakRSSGrowth);
+		if (m_countsAllocations)
+			entry["allocations"] = Json::UInt64(phase.allocations);
+	}
+	return result;
+}
+
+Profiler::ResourceUsage Profiler::resourceUsage()
+{
+	ResourceUsage result;
+#if defined(__linux__) || defined(__APPLE__)
+	rusage usage;
+#if defined(RUSAGE_THREAD)
+	if (getrusage(RUSAGE_THREAD, &usage) == 0)
+#else
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+#endif
+	{
+		auto toNanoseconds = [](timeval const& _time) {
+			return chrono::seconds(_time.tv_sec) + chrono::microseconds(_time.tv_usec);
+		};
+		result.cpuTime = toNanoseconds(usage.ru_utime) + toNanoseconds(usage.ru_stime);
+		result.minorPageFaults = uint64_t(usage.ru_minflt);
+	}
+#endif
+	result.peakRSS = peakResidentSetSize();
+	result.allocations = t_allocations;
+	return result;
+}
+
+uint64_t Profiler::peakResidentSetSize()
+{
+#if defined(__linux__) || defined(__APPLE__)
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	// Reported in bytes on macOS and in kilobytes on Linux.
+	return uint64_t(usage.ru_maxrss) / 1024;
+#else
+	return uint64_t(usage.ru_maxrss);
+#endif
+#else
+	return 0;
+#endif
+}
+
+ScopedProfile::ScopedProfile(char const* _phase, char const* _subPhase)
+{
+	Profiler& profiler = Profiler::instance();
+	if (!profiler.enabled())
+		return;
+	m_phase = _phase;
+	m_subPhase = _subPhase;
+	m_startUsage = Profiler::resourceUsage();
+	m_start = chrono::steady_clock::now();
+}
+
+ScopedProfile::~ScopedProfile()
+{
+	if (!m_phase)
+		return;
+	Profiler& profiler = Profiler::instance();
+	auto duration = chrono::steady_clock::now() - m_start;
+	string name = m_subPhase ? string(m_phase) + "/" + m_subPhase : string(m_phase);
+	profiler.record(name, chrono::duration_cast<chrono::nanoseconds>(duration), m_startUsage, Profiler::resourceUsage());
+}
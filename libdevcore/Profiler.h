@@ -0,0 +1,134 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Collection of time, allocation and memory statistics per compiler phase.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace dev
+{
+
+/**
+ * Process-wide registry of the time spent in named compiler phases.
+ * Recording is disabled by default and only costs a flag check in that case.
+ * Phases can be nested, the reported times of a phase include the time of all
+ * phases run inside of it.
+ */
+class Profiler: boost::noncopyable
+{
+public:
+	static Profiler& instance();
+
+	void setEnabled(bool _enabled) { m_enabled = _enabled; }
+	bool enabled() const { return m_enabled; }
+
+	/// Has to be called by executables that report each heap allocation through countAllocation().
+	/// Allocation counts are only included in the report if this is set.
+	void setCountsAllocations(bool _counts) { m_countsAllocations = _counts; }
+	/// Counts one heap allocation of the calling thread. Meant to be called from a replacement
+	/// of the global operator new, so it neither allocates nor locks.
+	static void countAllocation() noexcept;
+
+	/// Removes all recorded data.
+	void reset();
+
+	/// Resources used so far, as reported by getrusage. All values are zero on platforms
+	/// where they are not available.
+	struct ResourceUsage
+	{
+		/// User and system CPU time of the calling thread (of the process if the platform
+		/// does not report per-thread usage).
+		std::chrono::nanoseconds cpuTime{0};
+		/// Page faults served without I/O, i.e. mostly memory touched for the first time,
+		/// of the calling thread (of the process if the platform does not report per-thread usage).
+		uint64_t minorPageFaults = 0;
+		/// Peak resident set size of the process in kilobytes.
+		uint64_t peakRSS = 0;
+		/// Heap allocations of the calling thread reported through countAllocation().
+		uint64_t allocations = 0;
+	};
+	static ResourceUsage resourceUsage();
+
+	/// Records one run of a phase, given the resource usage at its start and its end.
+	void record(
+		std::string const& _phase,
+		std::chrono::nanoseconds _wallTime,
+		ResourceUsage const& _start,
+		ResourceUsage const& _end
+	);
+
+	/// @returns a JSON object containing the peak resident set size of the process in kilobytes
+	/// (if available) and, under "phases", the number of times each phase ran, its total
+	/// wall time and CPU time in milliseconds, the number of minor page faults during the phase,
+	/// by how many kilobytes the peak resident set size of the process grew during the phase
+	/// and, if allocations are counted, the number of heap allocations during the phase.
+	Json::Value report() const;
+
+	/// @returns the peak resident set size of the process in kilobytes or zero if it
+	/// cannot be determined on this platform.
+	static uint64_t peakResidentSetSize();
+
+private:
+	Profiler() = default;
+
+	struct Phase
+	{
+		uint64_t calls = 0;
+		std::chrono::nanoseconds wallTime{0};
+		std::chrono::nanoseconds cpuTime{0};
+		uint64_t minorPageFaults = 0;
+		uint64_t peakRSSGrowth = 0;
+		uint64_t allocations = 0;
+	};
+
+	std::atomic<bool> m_enabled{false};
+	std::atomic<bool> m_countsAllocations{false};
+	mutable std::mutex m_mutex;
+	std::map<std::string, Phase> m_phases;
+};
+
+/**
+ * Records the time and resources used between its construction and destruction under the
+ * given phase name if profiling is enabled. If a sub-phase is given, the time is recorded as "phase/sub-phase".
+ * The names have to outlive the object.
+ */
+class ScopedProfile: boost::noncopyable
+{
+public:
+	explicit ScopedProfile(char const* _phase, char const* _subPhase = nullptr);
+	~ScopedProfile();
+
+private:
+	char const* m_phase = nullptr;
+	char const* m_subPhase = nullptr;
+	std::chrono::steady_clock::time_point m_start;
+	Profiler::ResourceUsage m_startUsage;
+};
+
+}
@@ -0,0 +1,51 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Process-wide limit on the number of threads the compiler runs concurrently.
+ */
+
+#include <libdevcore/ThreadReservation.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace std;
+using namespace dev;
+
+namespace
+{
+/// Number of additional threads that may still be started.
+atomic<size_t>& availableThreads()
+{
+	static atomic<size_t> s_available{max<size_t>(thread::hardware_concurrency(), 1) - 1};
+	return s_available;
+}
+}
+
+ThreadReservation::ThreadReservation(size_t _wanted)
+{
+	size_t available = availableThreads().load();
+	do
+		m_count = min(_wanted, available);
+	while (!availableThreads().compare_exchange_weak(available, available - m_count));
+}
+
+ThreadReservation::~ThreadReservation()
+{
+	availableThreads() += m_count;
+}
@@ -0,0 +1,51 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Process-wide limit on the number of threads the compiler runs concurrently.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+
+namespace dev
+{
+
+/**
+ * Reserves additional threads from a budget of one thread per hardware thread that is shared by
+ * all parts of the compiler that run work concurrently, so that nested concurrent work (e.g.
+ * searching for constants inside of the concurrent optimisation of sub-assemblies) does not
+ * oversubscribe the machine. The calling thread itself is not counted.
+ * The threads are returned to the budget on destruction.
+ */
+class ThreadReservation: boost::noncopyable
+{
+public:
+	/// Reserves up to @a _wanted additional threads, fewer if the budget is exhausted.
+	explicit ThreadReservation(size_t _wanted);
+	~ThreadReservation();
+
+	/// @returns the number of additional threads that may be started.
+	size_t count() const { return m_count; }
+
+private:
+	size_t m_count = 0;
+};
+
+}
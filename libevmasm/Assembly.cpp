@@ -23,13 +23,20 @@
 
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/ControlFlowGraph.h>
+#include <libevmasm/DeadStoreEliminator.h>
 #include <libevmasm/PeepholeOptimiser.h>
+#include <libevmasm/StackShuffleOptimiser.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
 
+#include <libdevcore/Profiler.h>
+#include <libdevcore/ThreadReservation.h>
+
 #include <fstream>
+#include <functional>
+#include <future>
 #include <json/json.h>
 
 using namespace std;
@@ -96,14 +103,25 @@ void Assembly::injectStart(AssemblyItem const& _i)
 
 unsigned Assembly::bytesRequired(unsigned subTagSize) const
 {
+	// Only the items that push tags or data offsets depend on the tag size, so the
+	// remaining size and the number of such items are determined in a single pass.
+	unsigned fixedSize = 1;
+	for (auto const& i: m_data)
+		fixedSize += i.second.size();
+
+	unsigned tagSizedItems = 0;
+	for (AssemblyItem const& i: m_items)
+		if (i.type() == PushTag || i.type() == PushData || i.type() == PushSub)
+		{
+			fixedSize += 1;
+			tagSizedItems++;
+		}
+		else
+			fixedSize += i.bytesRequired(0);
+
 	for (unsigned tagSize = subTagSize; true; ++tagSize)
 	{
-		unsigned ret = 1;
-		for (auto const& i: m_data)
-			ret += i.second.size();
-
-		for (AssemblyItem const& i: m_items)
-			ret += i.bytesRequired(tagSize);
+		unsigned ret = fixedSize + tagSizedItems * tagSize;
 		if (dev::bytesRequired(ret) <= tagSize)
 			return ret;
 	}
@@ -384,6 +402,7 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
+	ScopedProfile profile("Assembly::optimise");
 	optimiseInternal(_settings, {});
 	return *this;
 }
@@ -394,18 +413,30 @@ map<u256, u256> Assembly::optimiseInternal(
 )
 {
 	// Run optimisation for sub-assemblies.
+	OptimiserSettings subSettings = _settings;
+	// Disable creation mode for sub-assemblies.
+	subSettings.isCreation = false;
+	// The sub-assemblies are optimised concurrently, unless an assembly is reachable
+	// from more than one of them (e.g. the creation code of a contract that is created both
+	// in the constructor and in the runtime code), because it would then be optimised
+	// concurrently with itself. Each task only modifies its own sub-assembly and
+	// the tag replacements are applied in order afterwards, so the result does not
+	// depend on the scheduling. Sub-assemblies for which no thread is available in the
+	// ThreadReservation are optimised by the current thread.
+	ThreadReservation threads((m_subs.size() > 1 && subAssembliesDisjoint()) ? m_subs.size() - 1 : 0);
+	vector<future<map<u256, u256>>> subTagReplacements;
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
-	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
+		subTagReplacements.emplace_back(async(
+			subId < threads.count() ? launch::async : launch::deferred,
+			[this, &subSettings, subId](set<size_t> _referencedTags)
+			{
+				return m_subs[subId]->optimiseInternal(subSettings, move(_referencedTags));
+			},
 			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
-	}
+		));
+	// Apply the replacements (can be empty).
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId].get(), subId);
 
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
@@ -415,6 +446,7 @@ map<u256, u256> Assembly::optimiseInternal(
 
 		if (_settings.runJumpdestRemover)
 		{
+			ScopedProfile profile("Assembly::optimise", "JumpdestRemover");
 			JumpdestRemover jumpdestOpt{m_items};
 			if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
 				count++;
@@ -422,17 +454,24 @@ map<u256, u256> Assembly::optimiseInternal(
 
 		if (_settings.runPeephole)
 		{
+			ScopedProfile profile("Assembly::optimise", "PeepholeOptimiser");
 			PeepholeOptimiser peepOpt{m_items};
-			while (peepOpt.optimise())
-			{
+			if (peepOpt.optimise())
+				count++;
+		}
+
+		if (_settings.runStackShuffle)
+		{
+			ScopedProfile profile("Assembly::optimise", "StackShuffleOptimiser");
+			StackShuffleOptimiser shuffleOpt{m_items};
+			if (shuffleOpt.optimise())
 				count++;
-				assertThrow(count < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
-			}
 		}
 
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
 		{
+			ScopedProfile profile("Assembly::optimise", "BlockDeduplicator");
 			BlockDeduplicator dedup{m_items};
 			if (dedup.deduplicate())
 			{
@@ -456,39 +495,70 @@ map<u256, u256> Assembly::optimiseInternal(
 			}
 		}
 
+		if (_settings.runCSE)
+		{
+			// Removes the stores that the common subexpression eliminator cannot see to be
+			// overwritten because the overwriting store is behind a tag.
+			ScopedProfile profile("Assembly::optimise", "DeadStoreEliminator");
+			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
+			DeadStoreEliminator deadStoreOpt{m_items, usesMSize};
+			if (deadStoreOpt.optimise())
+				count++;
+		}
+
 		if (_settings.runCSE)
 		{
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
+			// Instead, knowledge is only carried over to a block that can solely be entered by
+			// flowing into it from the previous block (e.g. the non-jumping branch of a JUMPI),
+			// i.e. from a block that dominates it.
+			ScopedProfile profile("Assembly::optimise", "CommonSubexpressionEliminator");
 			AssemblyItems optimisedItems;
 
 			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
 
+			KnownState state;
+			bool carryOverState = false;
 			auto iter = m_items.begin();
 			while (iter != m_items.end())
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
 				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
-				bool shouldReplace = false;
 				AssemblyItems optimisedChunk;
-				try
-				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < size_t(iter - orig));
-				}
-				catch (StackTooDeepException const&)
-				{
-					// This might happen if the opcode reconstruction is not as efficient
-					// as the hand-crafted code.
-				}
-				catch (ItemNotAvailableException const&)
+				auto eliminate = [&](KnownState const& _initialState)
 				{
-					// This might happen if e.g. associativity and commutativity rules
-					// reorganise the expression tree, but not all leaves are available.
-				}
+					CommonSubexpressionEliminator eliminator{_initialState};
+					iter = eliminator.feedItems(orig, m_items.end(), usesMSize);
+					bool success = false;
+					try
+					{
+						optimisedChunk = eliminator.getOptimizedItems();
+						success = true;
+					}
+					catch (StackTooDeepException const&)
+					{
+						// This might happen if the opcode reconstruction is not as efficient
+						// as the hand-crafted code.
+					}
+					catch (ItemNotAvailableException const&)
+					{
+						// This might happen if e.g. associativity and commutativity rules
+						// reorganise the expression tree, but not all leaves are available.
+					}
+					state = eliminator.state();
+					return success;
+				};
+				bool success = eliminate(carryOverState ? state : KnownState{});
+				if (!success && carryOverState)
+					// The prior knowledge might refer to values that are not available anymore.
+					success = eliminate(KnownState{});
+				bool shouldReplace = success && optimisedChunk.size() < size_t(iter - orig);
+
+				AssemblyItem const& lastItem = *prev(iter);
+				carryOverState =
+					lastItem.type() == Operation &&
+					(lastItem == AssemblyItem(Instruction::JUMPI) || !SemanticInformation::altersControlFlow(lastItem));
 
 				if (shouldReplace)
 				{
@@ -507,25 +577,53 @@ map<u256, u256> Assembly::optimiseInternal(
 	}
 
 	if (_settings.runConstantOptimiser)
+	{
+		ScopedProfile profile("Assembly::optimise", "ConstantOptimiser");
 		ConstantOptimisationMethod::optimiseConstants(
 			_settings.isCreation,
 			_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
 			*this
 		);
+	}
 
 	return tagReplacements;
 }
 
+bool Assembly::subAssembliesDisjoint() const
+{
+	set<Assembly const*> visited;
+	function<bool(Assembly const&)> visit = [&](Assembly const& _assembly)
+	{
+		for (auto const& sub: _assembly.m_subs)
+			if (!visited.insert(sub.get()).second || !visit(*sub))
+				return false;
+		return true;
+	};
+	return visit(*this);
+}
+
 LinkerObject const& Assembly::assemble() const
 {
 	if (!m_assembledObject.bytecode.empty())
 		return m_assembledObject;
 
+	ScopedProfile profile("Assembly::assemble");
+	// The sub-assemblies are assembled concurrently under the same condition under which
+	// they are optimised concurrently, since each of them only writes its own cached object.
+	ThreadReservation threads((m_subs.size() > 1 && subAssembliesDisjoint()) ? m_subs.size() - 1 : 0);
+	vector<future<void>> assembledSubs;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		assembledSubs.emplace_back(async(
+			subId < threads.count() ? launch::async : launch::deferred,
+			[sub = m_subs[subId].get()]() { sub->assemble(); }
+		));
+	for (auto& assembledSub: assembledSubs)
+		assembledSub.get();
+
 	size_t subTagSize = 1;
 	for (auto const& sub: m_subs)
 	{
-		sub->assemble();
 		for (size_t tagPos: sub->m_tagPositionsInBytecode)
 			if (tagPos != size_t(-1) && tagPos > subTagSize)
 				subTagSize = tagPos;
@@ -107,6 +107,7 @@ public:
 		bool runDeduplicate = false;
 		bool runCSE = false;
 		bool runConstantOptimiser = false;
+		bool runStackShuffle = false;
 		langutil::EVMVersion evmVersion;
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
@@ -159,6 +160,11 @@ protected:
 
 	unsigned bytesRequired(unsigned subTagSize) const;
 
+	/// @returns false if an assembly is reachable more than once from this assembly
+	/// through the sub-assemblies (including the case that it is a direct sub-assembly
+	/// multiple times).
+	bool subAssembliesDisjoint() const;
+
 private:
 	static Json::Value createJsonValue(std::string _name, int _begin, int _end, std::string _value = std::string(), std::string _jumpType = std::string());
 	static std::string toStringInHex(u256 _value);
@@ -77,6 +77,10 @@ public:
 	/// @returns the resulting items after optimization.
 	AssemblyItems getOptimizedItems();
 
+	/// @returns the knowledge about the state after the items fed so far, including the item
+	/// that breaks the basic block once the optimized items have been requested.
+	KnownState const& state() const { return m_state; }
+
 private:
 	/// Feeds the item into the system for analysis.
 	void feedItem(AssemblyItem const& _item, bool _copyItem = false);
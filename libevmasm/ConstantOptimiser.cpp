@@ -22,6 +22,13 @@
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
+
+#include <libdevcore/ThreadReservation.h>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+
 using namespace std;
 using namespace dev;
 using namespace dev::eth;
@@ -41,22 +48,50 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	for (AssemblyItem const& item: _items)
 		if (item.type() == Push)
 			pushes[item]++;
-	map<u256, AssemblyItems> pendingReplacements;
-	for (auto it: pushes)
+	vector<pair<AssemblyItem, size_t>> candidates;
+	for (auto const& it: pushes)
+		if (it.first.data() >= 0x100)
+			candidates.emplace_back(it);
+	auto paramsFor = [&](size_t _multiplicity)
 	{
-		AssemblyItem const& item = it.first;
-		if (item.data() < 0x100)
-			continue;
 		Params params;
-		params.multiplicity = it.second;
+		params.multiplicity = _multiplicity;
 		params.isCreation = _isCreation;
 		params.runs = _runs;
 		params.evmVersion = _evmVersion;
+		return params;
+	};
+
+	// Searching for a computation is the expensive part and independent for each constant,
+	// so it is done concurrently for larger numbers of constants, as far as threads are available.
+	vector<unique_ptr<ComputeMethod>> computeMethods(candidates.size());
+	atomic<size_t> nextCandidate{0};
+	auto findComputations = [&]()
+	{
+		for (size_t i = nextCandidate++; i < candidates.size(); i = nextCandidate++)
+			computeMethods[i] = make_unique<ComputeMethod>(
+				paramsFor(candidates[i].second),
+				candidates[i].first.data()
+			);
+	};
+	ThreadReservation threads(candidates.size() < 16 ? 0 : candidates.size() / 8 - 1);
+	vector<future<void>> workers;
+	for (size_t i = 0; i < threads.count(); ++i)
+		workers.emplace_back(async(launch::async, findComputations));
+	findComputations();
+	for (auto& worker: workers)
+		worker.get();
+
+	map<u256, AssemblyItems> pendingReplacements;
+	for (size_t i = 0; i < candidates.size(); ++i)
+	{
+		AssemblyItem const& item = candidates[i].first;
+		Params params = paramsFor(candidates[i].second);
 		LiteralMethod lit(params, item.data());
 		bigint literalGas = lit.gasNeeded();
 		CodeCopyMethod copy(params, item.data());
 		bigint copyGas = copy.gasNeeded();
-		ComputeMethod compute(params, item.data());
+		ComputeMethod const& compute = *computeMethods[i];
 		bigint computeGas = compute.gasNeeded();
 		AssemblyItems replacement;
 		if (copyGas < literalGas && copyGas < computeGas)
@@ -77,6 +112,50 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	return optimisations;
 }
 
+bool ConstantRepresentationCache::Key::operator<(Key const& _other) const
+{
+	return
+		tie(value, costModel, isCreation, runs, multiplicity, evmVersion) <
+		tie(_other.value, _other.costModel, _other.isCreation, _other.runs, _other.multiplicity, _other.evmVersion);
+}
+
+namespace
+{
+mutex& cacheMutex()
+{
+	static mutex s_mutex;
+	return s_mutex;
+}
+
+map<ConstantRepresentationCache::Key, ConstantRepresentationCache::Entry>& cacheEntries()
+{
+	static map<ConstantRepresentationCache::Key, ConstantRepresentationCache::Entry> s_entries;
+	return s_entries;
+}
+}
+
+optional<ConstantRepresentationCache::Entry> ConstantRepresentationCache::find(Key const& _key)
+{
+	lock_guard<mutex> lock(cacheMutex());
+	auto it = cacheEntries().find(_key);
+	if (it == cacheEntries().end())
+		return nullopt;
+	return it->second;
+}
+
+void ConstantRepresentationCache::store(Key const& _key, Entry _entry)
+{
+	lock_guard<mutex> lock(cacheMutex());
+	if (cacheEntries().size() < c_maxEntries)
+		cacheEntries().emplace(_key, move(_entry));
+}
+
+void ConstantRepresentationCache::clear()
+{
+	lock_guard<mutex> lock(cacheMutex());
+	cacheEntries().clear();
+}
+
 bigint ConstantOptimisationMethod::simpleRunGas(AssemblyItems const& _items)
 {
 	bigint gas = 0;
@@ -190,7 +269,33 @@ AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 	if (_value < 0x10000)
 		// Very small value, not worth computing
 		return AssemblyItems{_value};
-	else if (dev::bytesRequired(~_value) < dev::bytesRequired(_value))
+
+	ConstantRepresentationCache::Key key{
+		_value,
+		ConstantRepresentationCache::CostModel::Assembly,
+		m_params.isCreation,
+		m_params.runs,
+		m_params.multiplicity,
+		m_params.evmVersion
+	};
+	if (optional<ConstantRepresentationCache::Entry> entry = ConstantRepresentationCache::find(key))
+		if (entry->steps < m_maxSteps)
+		{
+			m_maxSteps -= entry->steps;
+			return move(entry->routine);
+		}
+
+	size_t stepsBefore = m_maxSteps;
+	AssemblyItems routine = searchRepresentation(_value);
+	// If the steps ran out, the search was cut short and a later search might find a better routine.
+	if (m_maxSteps > 0)
+		ConstantRepresentationCache::store(key, {routine, stepsBefore - m_maxSteps});
+	return routine;
+}
+
+AssemblyItems ComputeMethod::searchRepresentation(u256 const& _value)
+{
+	if (dev::bytesRequired(~_value) < dev::bytesRequired(_value))
 		// Negated is shorter to represent
 		return findRepresentation(~_value) + AssemblyItems{Instruction::NOT};
 	else
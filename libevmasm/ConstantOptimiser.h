@@ -29,6 +29,7 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonIO.h>
 
+#include <optional>
 #include <vector>
 
 namespace dev
@@ -40,6 +41,53 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 class Assembly;
 
+/**
+ * Process-wide cache of the cheapest computations of constants found by the constant optimisers
+ * of the assembly and of Yul, which are asked for the same constants (masks, selectors, ...)
+ * again and again across contracts.
+ * The number of entries is bounded and the cache is cleared explicitly between compilations
+ * of long-running processes. Thread-safe.
+ */
+class ConstantRepresentationCache
+{
+public:
+	enum class CostModel { Assembly, Yul };
+
+	/// The value of the constant and everything its costs depend on.
+	struct Key
+	{
+		u256 value;
+		CostModel costModel;
+		bool isCreation;
+		size_t runs;
+		size_t multiplicity;
+		langutil::EVMVersion evmVersion;
+
+		bool operator<(Key const& _other) const;
+	};
+
+	struct Entry
+	{
+		/// Pushes and operations that compute the constant.
+		AssemblyItems routine;
+		/// Number of search steps it took to find the routine. An entry is only used if the
+		/// current search has more steps left than that, because the search would then have
+		/// found the same routine. This way, the result does not depend on which constants
+		/// were optimised before.
+		size_t steps = 0;
+	};
+
+	/// Maximum number of entries, further entries are not stored.
+	static size_t constexpr c_maxEntries = 0x4000;
+
+	/// @returns the entry for @a _key if there is one.
+	static std::optional<Entry> find(Key const& _key);
+	/// Stores @a _entry for @a _key unless there already is an entry or the cache is full.
+	static void store(Key const& _key, Entry _entry);
+	/// Removes all entries.
+	static void clear();
+};
+
 /**
  * Abstract base class for one way to change how constants are represented in the code.
  */
@@ -152,8 +200,11 @@ public:
 	}
 
 protected:
-	/// Tries to recursively find a way to compute @a _value.
+	/// Tries to recursively find a way to compute @a _value, using previous results from the
+	/// ConstantRepresentationCache.
 	AssemblyItems findRepresentation(u256 const& _value);
+	/// Searches for a way to compute @a _value by decomposing it.
+	AssemblyItems searchRepresentation(u256 const& _value);
 	/// Recomputes the value from the calculated representation and checks for correctness.
 	bool checkRepresentation(u256 const& _value, AssemblyItems const& _routine) const;
 	bigint gasNeeded(AssemblyItems const& _routine) const;
@@ -0,0 +1,122 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Removes storage and memory writes that are overwritten before they can be observed.
+ */
+
+#include <libevmasm/DeadStoreEliminator.h>
+
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/KnownState.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <map>
+#include <set>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+
+using Id = ExpressionClasses::Id;
+
+/// Removes the pending stores whose location might be the same as @a _location.
+template <class KnownToBeDifferent>
+void removeAliases(map<Id, size_t>& _pendingStores, Id _location, KnownToBeDifferent _knownToBeDifferent)
+{
+	for (auto it = _pendingStores.begin(); it != _pendingStores.end();)
+		if (_knownToBeDifferent(it->first, _location))
+			++it;
+		else
+			it = _pendingStores.erase(it);
+}
+
+}
+
+bool DeadStoreEliminator::optimise()
+{
+	set<size_t> deadStores;
+
+	KnownState state;
+	// Stores that have not been read (yet), by location, with their position in the items.
+	map<Id, size_t> pendingStorageStores;
+	map<Id, size_t> pendingMemoryStores;
+
+	auto recordStore = [&](map<Id, size_t>& _pendingStores, size_t _position)
+	{
+		Id location = state.relativeStackElement(0);
+		auto it = _pendingStores.find(location);
+		if (it != _pendingStores.end())
+			deadStores.insert(it->second);
+		_pendingStores[location] = _position;
+	};
+
+	for (size_t i = 0; i < m_items.size(); ++i)
+	{
+		AssemblyItem const& item = m_items[i];
+		if (SemanticInformation::altersControlFlow(item))
+		{
+			state = KnownState();
+			pendingStorageStores.clear();
+			pendingMemoryStores.clear();
+			continue;
+		}
+
+		if (item.type() == Operation)
+		{
+			Instruction instruction = item.instruction();
+			if (instruction == Instruction::SSTORE)
+				recordStore(pendingStorageStores, i);
+			else if (instruction == Instruction::MSTORE && !m_usesMSize)
+				recordStore(pendingMemoryStores, i);
+			else if (instruction == Instruction::SLOAD)
+				removeAliases(pendingStorageStores, state.relativeStackElement(0), [&](Id _a, Id _b) {
+					return state.expressionClasses().knownToBeDifferent(_a, _b);
+				});
+			else if (instruction == Instruction::MLOAD)
+				removeAliases(pendingMemoryStores, state.relativeStackElement(0), [&](Id _a, Id _b) {
+					return state.expressionClasses().knownToBeDifferentBy32(_a, _b);
+				});
+			else
+			{
+				if (SemanticInformation::readsStorage(instruction))
+					pendingStorageStores.clear();
+				if (SemanticInformation::readsMemory(instruction))
+					pendingMemoryStores.clear();
+			}
+		}
+		state.feedItem(item);
+	}
+
+	if (deadStores.empty())
+		return false;
+
+	AssemblyItems items;
+	items.reserve(m_items.size() + deadStores.size());
+	for (size_t i = 0; i < m_items.size(); ++i)
+		if (deadStores.count(i))
+		{
+			items.emplace_back(Instruction::POP, m_items[i].location());
+			items.emplace_back(Instruction::POP, m_items[i].location());
+		}
+		else
+			items.push_back(m_items[i]);
+	m_items = move(items);
+	return true;
+}
@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Removes storage and memory writes that are overwritten before they can be observed.
+ */
+#pragma once
+
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+class AssemblyItem;
+using AssemblyItems = std::vector<AssemblyItem>;
+
+/**
+ * Optimisation stage that removes SSTORE and MSTORE operations that are followed by a write
+ * to the same location on every path, with no operation in between that can read the location.
+ *
+ * The common subexpression eliminator already does this inside its blocks, but it has to
+ * start from scratch at each tag. This stage follows the code across tags that are reached
+ * by flowing into them, since every execution of a store in front of such a tag continues
+ * behind it, and compares locations using the knowledge gathered along that path.
+ * The analysis stops at every instruction that alters control flow.
+ * Removed stores are replaced by POPs of their arguments, which are cleaned up by the
+ * other stages.
+ */
+class DeadStoreEliminator
+{
+public:
+	/// @param _usesMSize if true, memory writes are kept since they can influence msize.
+	DeadStoreEliminator(AssemblyItems& _items, bool _usesMSize):
+		m_items(_items), m_usesMSize(_usesMSize)
+	{}
+
+	/// @returns true if any store was removed.
+	bool optimise();
+
+private:
+	AssemblyItems& m_items;
+	bool m_usesMSize = false;
+};
+
+}
+}
@@ -25,6 +25,7 @@
 #include <utility>
 #include <tuple>
 #include <functional>
+#include <limits>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/noncopyable.hpp>
 #include <libevmasm/Assembly.h>
@@ -36,25 +37,42 @@ using namespace dev;
 using namespace dev::eth;
 using namespace langutil;
 
-bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression const& _other) const
+namespace
+{
+void hashCombine(size_t& _seed, size_t _value)
+{
+	_seed ^= _value + 0x9e3779b9 + (_seed << 6) + (_seed >> 2);
+}
+}
+
+bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression const& _other) const
 {
 	assertThrow(!!item && !!_other.item, OptimizerException, "");
-	auto type = item->type();
-	auto otherType = _other.item->type();
-	if (type != otherType)
-		return type < otherType;
-	else if (type == Operation)
-	{
-		auto instr = item->instruction();
-		auto otherInstr = _other.item->instruction();
-		return std::tie(instr, arguments, sequenceNumber) <
-			std::tie(otherInstr, _other.arguments, _other.sequenceNumber);
-	}
+	if (item->type() != _other.item->type())
+		return false;
+	else if (item->type() == Operation)
+		return
+			item->instruction() == _other.item->instruction() &&
+			std::tie(arguments, sequenceNumber) == std::tie(_other.arguments, _other.sequenceNumber);
 	else
-		return std::tie(item->data(), arguments, sequenceNumber) <
+		return std::tie(item->data(), arguments, sequenceNumber) ==
 			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
 }
 
+size_t ExpressionClasses::Expression::hash() const
+{
+	assertThrow(!!item, OptimizerException, "");
+	size_t result = size_t(item->type());
+	if (item->type() == Operation)
+		hashCombine(result, size_t(item->instruction()));
+	else
+		hashCombine(result, size_t(item->data() & numeric_limits<size_t>::max()));
+	for (Id argument: arguments)
+		hashCombine(result, argument);
+	hashCombine(result, sequenceNumber);
+	return result;
+}
+
 ExpressionClasses::Id ExpressionClasses::find(
 	AssemblyItem const& _item,
 	Ids const& _arguments,
@@ -73,9 +91,9 @@ ExpressionClasses::Id ExpressionClasses::find(
 
 	if (SemanticInformation::isDeterministic(_item))
 	{
-		auto it = m_expressions.find(exp);
-		if (it != m_expressions.end())
-			return it->id;
+		size_t index = findExpression(exp);
+		if (index < m_expressions.size())
+			return m_expressions[index].id;
 	}
 
 	if (_copyItem)
@@ -89,7 +107,7 @@ ExpressionClasses::Id ExpressionClasses::find(
 		exp.id = m_representatives.size();
 		m_representatives.push_back(exp);
 	}
-	m_expressions.insert(exp);
+	insertExpression(exp);
 	return exp.id;
 }
 
@@ -111,7 +129,7 @@ void ExpressionClasses::forceEqual(
 	if (_copyItem)
 		exp.item = storeItem(_item);
 
-	m_expressions.insert(exp);
+	insertExpression(exp);
 }
 
 ExpressionClasses::Id ExpressionClasses::newClass(SourceLocation const& _location)
@@ -120,10 +138,48 @@ ExpressionClasses::Id ExpressionClasses::newClass(SourceLocation const& _locatio
 	exp.id = m_representatives.size();
 	exp.item = storeItem(AssemblyItem(UndefinedItem, (u256(1) << 255) + exp.id, _location));
 	m_representatives.push_back(exp);
-	m_expressions.insert(exp);
+	insertExpression(exp);
 	return exp.id;
 }
 
+size_t ExpressionClasses::findExpression(Expression const& _expr) const
+{
+	if (m_expressionIndex.empty())
+		return m_expressions.size();
+	size_t mask = m_expressionIndex.size() - 1;
+	for (size_t slot = _expr.hash() & mask; m_expressionIndex[slot]; slot = (slot + 1) & mask)
+		if (m_expressions[m_expressionIndex[slot] - 1] == _expr)
+			return m_expressionIndex[slot] - 1;
+	return m_expressions.size();
+}
+
+void ExpressionClasses::insertExpression(Expression const& _expr)
+{
+	if (findExpression(_expr) < m_expressions.size())
+		return;
+	if (2 * (m_expressions.size() + 1) > m_expressionIndex.size())
+		growExpressionIndex();
+	m_expressions.push_back(_expr);
+	size_t mask = m_expressionIndex.size() - 1;
+	size_t slot = _expr.hash() & mask;
+	while (m_expressionIndex[slot])
+		slot = (slot + 1) & mask;
+	m_expressionIndex[slot] = m_expressions.size();
+}
+
+void ExpressionClasses::growExpressionIndex()
+{
+	m_expressionIndex.assign(max<size_t>(64, 2 * m_expressionIndex.size()), 0);
+	size_t mask = m_expressionIndex.size() - 1;
+	for (size_t i = 0; i < m_expressions.size(); ++i)
+	{
+		size_t slot = m_expressions[i].hash() & mask;
+		while (m_expressionIndex[slot])
+			slot = (slot + 1) & mask;
+		m_expressionIndex[slot] = i + 1;
+	}
+}
+
 bool ExpressionClasses::knownToBeDifferent(ExpressionClasses::Id _a, ExpressionClasses::Id _b)
 {
 	// Try to simplify "_a - _b" and return true iff the value is a non-zero constant.
@@ -150,7 +206,7 @@ bool ExpressionClasses::knownNonZero(Id _c)
 
 u256 const* ExpressionClasses::knownConstant(Id _c)
 {
-	map<unsigned, Expression const*> matchGroups;
+	MatchGroups<Expression> matchGroups;
 	Pattern constant(Push);
 	constant.setMatchGroup(1, matchGroups);
 	if (!constant.matches(representative(_c), *this))
@@ -183,7 +239,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// Sub-assemblies are optimised concurrently, but the match groups of the rules are thread-local.
+	static Rules const rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
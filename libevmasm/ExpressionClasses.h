@@ -62,7 +62,9 @@ public:
 		/// Storage modification sequence, only used for storage and memory operations.
 		unsigned sequenceNumber = 0;
 		/// Behaves as if this was a tuple of (item->type(), item->data(), arguments, sequenceNumber).
-		bool operator<(Expression const& _other) const;
+		bool operator==(Expression const& _other) const;
+		/// @returns a hash value that is consistent with operator==.
+		size_t hash() const;
 	};
 
 	/// Retrieves the id of the expression equivalence class resulting from the given item applied to the
@@ -120,10 +122,22 @@ private:
 
 	std::vector<std::pair<Pattern, std::function<Pattern()>>> createRules() const;
 
+	/// @returns the index of an encountered expression equal to @a _expr in m_expressions or
+	/// m_expressions.size() if there is none.
+	size_t findExpression(Expression const& _expr) const;
+	/// Records @a _expr as encountered unless an equal expression was already recorded.
+	void insertExpression(Expression const& _expr);
+	/// Doubles the size of the hash index and re-inserts all encountered expressions.
+	void growExpressionIndex();
+
 	/// Expression equivalence class representatives - we only store one item of an equivalence.
 	std::vector<Expression> m_representatives;
-	/// All expression ever encountered.
-	std::set<Expression> m_expressions;
+	/// All expression ever encountered, in the order in which they were encountered.
+	std::vector<Expression> m_expressions;
+	/// Open addressing hash table (linear probing) of indices into m_expressions, shifted by one
+	/// so that zero marks an empty slot. Its size is a power of two and at least twice the number
+	/// of encountered expressions.
+	std::vector<size_t> m_expressionIndex;
 	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
 };
 
@@ -24,6 +24,8 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <array>
+
 using namespace std;
 using namespace dev::eth;
 using namespace dev;
@@ -35,9 +37,13 @@ namespace
 
 struct OptimiserState
 {
-	AssemblyItems const& items;
-	size_t i;
-	std::back_insert_iterator<AssemblyItems> out;
+	/// Items that are still to be processed, in reverse order, i.e. the next item is at the back.
+	/// Reverse iterators thus see the items in their original order.
+	AssemblyItems pending;
+	/// Number of pending items replaced by the method that was applied.
+	size_t consumed = 0;
+	/// Items the consumed items are replaced with.
+	AssemblyItems replacement;
 };
 
 template <class Method, size_t Arguments>
@@ -47,7 +53,7 @@ struct ApplyRule
 template <class Method>
 struct ApplyRule<Method, 4>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(AssemblyItems::const_reverse_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		return Method::applySimple(_in[0], _in[1], _in[2], _in[3], _out);
 	}
@@ -55,7 +61,7 @@ struct ApplyRule<Method, 4>
 template <class Method>
 struct ApplyRule<Method, 3>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(AssemblyItems::const_reverse_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		return Method::applySimple(_in[0], _in[1], _in[2], _out);
 	}
@@ -63,7 +69,7 @@ struct ApplyRule<Method, 3>
 template <class Method>
 struct ApplyRule<Method, 2>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(AssemblyItems::const_reverse_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		return Method::applySimple(_in[0], _in[1], _out);
 	}
@@ -71,7 +77,7 @@ struct ApplyRule<Method, 2>
 template <class Method>
 struct ApplyRule<Method, 1>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(AssemblyItems::const_reverse_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		return Method::applySimple(_in[0], _out);
 	}
@@ -83,11 +89,11 @@ struct SimplePeepholeOptimizerMethod
 	static bool apply(OptimiserState& _state)
 	{
 		if (
-			_state.i + WindowSize <= _state.items.size() &&
-			ApplyRule<Method, WindowSize>::applyRule(_state.items.begin() + _state.i, _state.out)
+			WindowSize <= _state.pending.size() &&
+			ApplyRule<Method, WindowSize>::applyRule(_state.pending.crbegin(), std::back_inserter(_state.replacement))
 		)
 		{
-			_state.i += WindowSize;
+			_state.consumed = WindowSize;
 			return true;
 		}
 		else
@@ -95,30 +101,27 @@ struct SimplePeepholeOptimizerMethod
 	}
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity, 1>
-{
-	static bool applySimple(AssemblyItem const& _item, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		*_out = _item;
-		return true;
-	}
-};
-
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop, 2>
 {
-	static bool applySimple(AssemblyItem const& _push, AssemblyItem const& _pop, std::back_insert_iterator<AssemblyItems>)
+	static bool firstItem(AssemblyItem const& _push)
 	{
 		auto t = _push.type();
-		return _pop == Instruction::POP && (
+		return
 			SemanticInformation::isDupInstruction(_push) ||
 			t == Push || t == PushString || t == PushTag || t == PushSub ||
-			t == PushSubSize || t == PushProgramSize || t == PushData || t == PushLibraryAddress
-		);
+			t == PushSubSize || t == PushProgramSize || t == PushData || t == PushLibraryAddress;
+	}
+
+	static bool applySimple(AssemblyItem const& _push, AssemblyItem const& _pop, std::back_insert_iterator<AssemblyItems>)
+	{
+		return _pop == Instruction::POP && firstItem(_push);
 	}
 };
 
 struct OpPop: SimplePeepholeOptimizerMethod<OpPop, 2>
 {
+	static bool firstItem(AssemblyItem const& _op) { return _op.type() == Operation; }
+
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _pop,
@@ -141,6 +144,8 @@ struct OpPop: SimplePeepholeOptimizerMethod<OpPop, 2>
 
 struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap, 2>
 {
+	static bool firstItem(AssemblyItem const& _s1) { return SemanticInformation::isSwapInstruction(_s1); }
+
 	static size_t applySimple(AssemblyItem const& _s1, AssemblyItem const& _s2, std::back_insert_iterator<AssemblyItems>)
 	{
 		return _s1 == _s2 && SemanticInformation::isSwapInstruction(_s1);
@@ -149,6 +154,8 @@ struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap, 2>
 
 struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush, 2>
 {
+	static bool firstItem(AssemblyItem const& _push1) { return _push1.type() == Push; }
+
 	static bool applySimple(AssemblyItem const& _push1, AssemblyItem const& _push2, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		if (_push1.type() == Push && _push2.type() == Push && _push1.data() == _push2.data())
@@ -164,6 +171,8 @@ struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush, 2>
 
 struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap, 2>
 {
+	static bool firstItem(AssemblyItem const& _swap) { return _swap == Instruction::SWAP1; }
+
 	static bool applySimple(AssemblyItem const& _swap, AssemblyItem const& _op, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		// Remove SWAP1 if following instruction is commutative
@@ -182,6 +191,8 @@ struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap, 2>
 
 struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison, 2>
 {
+	static bool firstItem(AssemblyItem const& _swap) { return _swap == Instruction::SWAP1; }
+
 	static bool applySimple(AssemblyItem const& _swap, AssemblyItem const& _op, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		static map<Instruction, Instruction> const swappableOps{
@@ -207,6 +218,8 @@ struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison, 2>
 
 struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI, 4>
 {
+	static bool firstItem(AssemblyItem const& _iszero1) { return _iszero1 == Instruction::ISZERO; }
+
 	static size_t applySimple(
 		AssemblyItem const& _iszero1,
 		AssemblyItem const& _iszero2,
@@ -233,6 +246,8 @@ struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI, 4>
 
 struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext, 3>
 {
+	static bool firstItem(AssemblyItem const& _pushTag) { return _pushTag.type() == PushTag; }
+
 	static size_t applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _jump,
@@ -259,6 +274,8 @@ struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext, 3>
 
 struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions, 3>
 {
+	static bool firstItem(AssemblyItem const& _pushTag) { return _pushTag.type() == PushTag; }
+
 	static bool applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _pushConstant,
@@ -283,6 +300,8 @@ struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions, 3>
 
 struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 {
+	static bool firstItem(AssemblyItem const& _push) { return _push.type() == Push; }
+
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _not,
@@ -301,20 +320,22 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
+	static bool firstItem(AssemblyItem const& _item)
+	{
+		return
+			_item == Instruction::JUMP ||
+			_item == Instruction::RETURN ||
+			_item == Instruction::STOP ||
+			_item == Instruction::INVALID ||
+			_item == Instruction::SELFDESTRUCT ||
+			_item == Instruction::REVERT;
+	}
+
 	static bool apply(OptimiserState& _state)
 	{
-		auto it = _state.items.begin() + _state.i;
-		auto end = _state.items.end();
-		if (it == end)
-			return false;
-		if (
-			it[0] != Instruction::JUMP &&
-			it[0] != Instruction::RETURN &&
-			it[0] != Instruction::STOP &&
-			it[0] != Instruction::INVALID &&
-			it[0] != Instruction::SELFDESTRUCT &&
-			it[0] != Instruction::REVERT
-		)
+		auto it = _state.pending.crbegin();
+		auto end = _state.pending.crend();
+		if (it == end || !firstItem(it[0]))
 			return false;
 
 		size_t i = 1;
@@ -322,8 +343,8 @@ struct UnreachableCode
 			i++;
 		if (i > 1)
 		{
-			*_state.out = it[0];
-			_state.i += i;
+			_state.replacement.push_back(it[0]);
+			_state.consumed = i;
 			return true;
 		}
 		else
@@ -331,17 +352,48 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+/// Table of the methods that can apply to a window starting with a given item,
+/// in the order in which they are tried.
+class MethodTable
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
-}
+public:
+	using Method = bool(*)(OptimiserState&);
 
-template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
-{
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
-}
+	/// Maximum number of items a method depends on, apart from UnreachableCode,
+	/// which does not depend on the items before the jump.
+	static size_t constexpr maxWindowSize = 4;
+
+	template <typename... Methods>
+	explicit MethodTable(Methods...)
+	{
+		for (size_t i = 0; i < m_operations.size(); ++i)
+			m_operations[i] = methodsFor<Methods...>(AssemblyItem(Instruction(i)));
+		for (size_t i = 0; i < m_otherItems.size(); ++i)
+			if (AssemblyItemType(i) != Operation)
+				m_otherItems[i] = methodsFor<Methods...>(AssemblyItem(AssemblyItemType(i)));
+	}
+
+	std::vector<Method> const& methods(AssemblyItem const& _first) const
+	{
+		if (_first.type() == Operation)
+			return m_operations[size_t(_first.instruction())];
+		return m_otherItems[size_t(_first.type())];
+	}
+
+private:
+	template <typename... Methods>
+	static std::vector<Method> methodsFor(AssemblyItem const& _first)
+	{
+		std::vector<Method> result;
+		for (auto const& [applies, method]: {std::make_pair(Methods::firstItem(_first), &Methods::apply)...})
+			if (applies)
+				result.push_back(method);
+		return result;
+	}
+
+	std::array<std::vector<Method>, 256> m_operations;
+	std::array<std::vector<Method>, size_t(PushDeployTimeAddress) + 1> m_otherItems;
+};
 
 size_t numberOfPops(AssemblyItems const& _items)
 {
@@ -352,14 +404,48 @@ size_t numberOfPops(AssemblyItems const& _items)
 
 bool PeepholeOptimiser::optimise()
 {
-	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
-	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
+	static MethodTable const table{
+		PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
+		IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
+		TagConjunctions(), TruthyAnd()
+	};
+
+	// The items are processed from left to right. Whenever a method is applied, its
+	// replacement is put back in front of the unprocessed items, together with the last
+	// processed items it could form a new window with. This way, a single run over
+	// the items applies the methods until none of them matches anymore.
+	// Every method removes or simplifies items, so they can only be applied a limited number
+	// of times. Hitting the limit means that some methods undo each other.
+	size_t const maxApplications = 64000 + 16 * m_items.size();
+	size_t applications = 0;
+	OptimiserState state;
+	state.pending.assign(m_items.rbegin(), m_items.rend());
+	m_optimisedItems.clear();
+	m_optimisedItems.reserve(m_items.size());
+	while (!state.pending.empty())
+	{
+		bool applied = false;
+		for (auto method: table.methods(state.pending.back()))
+			if ((applied = method(state)))
+				break;
+		if (!applied)
+		{
+			m_optimisedItems.push_back(std::move(state.pending.back()));
+			state.pending.pop_back();
+			continue;
+		}
+		assertThrow(++applications < maxApplications, OptimizerException, "Peephole optimizer seems to be stuck.");
+
+		state.pending.erase(state.pending.end() - ptrdiff_t(state.consumed), state.pending.end());
+		state.pending.insert(state.pending.end(), state.replacement.rbegin(), state.replacement.rend());
+		state.replacement.clear();
+		for (size_t i = 1; i < MethodTable::maxWindowSize && !m_optimisedItems.empty(); ++i)
+		{
+			state.pending.push_back(std::move(m_optimisedItems.back()));
+			m_optimisedItems.pop_back();
+		}
+	}
+
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
 			eth::bytesRequired(m_optimisedItems, 3) < eth::bytesRequired(m_items, 3) ||
@@ -262,6 +262,48 @@ bool SemanticInformation::invalidatesStorage(Instruction _instruction)
 	}
 }
 
+bool SemanticInformation::readsMemory(Instruction _instruction)
+{
+	switch (_instruction)
+	{
+	case Instruction::MLOAD:
+	case Instruction::KECCAK256:
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+	case Instruction::RETURN:
+	case Instruction::REVERT:
+	case Instruction::LOG0:
+	case Instruction::LOG1:
+	case Instruction::LOG2:
+	case Instruction::LOG3:
+	case Instruction::LOG4:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool SemanticInformation::readsStorage(Instruction _instruction)
+{
+	switch (_instruction)
+	{
+	case Instruction::SLOAD:
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		return true;
+	default:
+		return false;
+	}
+}
+
 bool SemanticInformation::invalidInPureFunctions(Instruction _instruction)
 {
 	switch (_instruction)
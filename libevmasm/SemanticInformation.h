@@ -70,6 +70,10 @@ struct SemanticInformation
 	static bool invalidatesMemory(Instruction _instruction);
 	/// @returns true if the given instruction modifies storage (even indirectly).
 	static bool invalidatesStorage(Instruction _instruction);
+	/// @returns true if the given instruction reads memory.
+	static bool readsMemory(Instruction _instruction);
+	/// @returns true if the given instruction reads storage (even indirectly).
+	static bool readsStorage(Instruction _instruction);
 	static bool invalidInPureFunctions(Instruction _instruction);
 	static bool invalidInViewFunctions(Instruction _instruction);
 };
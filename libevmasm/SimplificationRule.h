@@ -21,7 +21,14 @@
 #pragma once
 
 #include <libevmasm/Instruction.h>
+#include <libevmasm/Exceptions.h>
+#include <libdevcore/Assertions.h>
+
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <optional>
+#include <vector>
 
 namespace dev
 {
@@ -55,6 +62,161 @@ struct SimplificationRule
 	std::function<bool()> feasible;
 };
 
+/**
+ * Expressions matched by the patterns of a rule, indexed by their match group.
+ * Match groups are small positive numbers, so this is a flat array that is cheap to reset.
+ * The match groups of rules that are shared between threads are thread-local: Each thread
+ * has its own expressions, which all thread-local match groups of the thread share.
+ */
+template <class Expression>
+class MatchGroups
+{
+public:
+	static size_t constexpr maxGroup = 7;
+
+	explicit MatchGroups(bool _threadLocal = false): m_threadLocal(_threadLocal) {}
+
+	bool count(unsigned _group) const { return expressions()[index(_group)] != nullptr; }
+	Expression const*& operator[](unsigned _group) { return expressions()[index(_group)]; }
+	void clear() { expressions().fill(nullptr); }
+
+private:
+	using Expressions = std::array<Expression const*, maxGroup>;
+
+	static size_t index(unsigned _group)
+	{
+		assertThrow(0 < _group && _group <= maxGroup, OptimizerException, "Invalid match group.");
+		return _group - 1;
+	}
+
+	Expressions& expressions() const
+	{
+		thread_local Expressions threadExpressions{};
+		return m_threadLocal ? threadExpressions : m_expressions;
+	}
+
+	bool m_threadLocal = false;
+	mutable Expressions m_expressions{};
+};
+
+/**
+ * Simplification rules indexed by the instruction at the root of their pattern and the
+ * "shapes" of the arguments of the root. The shape of an expression is its instruction
+ * if it is an operation, constantShape if it is a constant and otherShape otherwise.
+ * A pattern argument without a shape (i.e. one that matches anything) is compatible with
+ * all shapes, otherwise the shapes have to be equal.
+ * Once all rules are added, build() determines the compatible rules for each combination of
+ * the shapes the patterns of an instruction require, so most rules never have to be matched
+ * against an expression and lookups do not modify the index.
+ */
+template <class Pattern>
+class SimplificationRuleIndex
+{
+public:
+	using Rule = SimplificationRule<Pattern>;
+
+	static unsigned constexpr constantShape = 0x100;
+	static unsigned constexpr otherShape = 0x101;
+
+	void add(Rule const& _rule)
+	{
+		assertThrow(!m_built, OptimizerException, "Rules added after the index was built.");
+		m_buckets[uint8_t(_rule.pattern.instruction())].rules.push_back(_rule);
+	}
+
+	/// Determines the candidates for all combinations of argument shapes.
+	void build()
+	{
+		for (Bucket& bucket: m_buckets)
+			bucket.build();
+		m_built = true;
+	}
+
+	bool empty(Instruction _instruction) const { return m_buckets[uint8_t(_instruction)].rules.empty(); }
+
+	/// @returns the rules whose patterns can match an operation with the instruction @a _instruction
+	/// and @a _arguments arguments, in the order in which they were added.
+	/// @a _argumentShape is called with the index of an argument and returns its shape.
+	template <class ArgumentShape>
+	std::vector<Rule const*> const& candidates(
+		Instruction _instruction,
+		size_t _arguments,
+		ArgumentShape const& _argumentShape
+	) const
+	{
+		assertThrow(m_built, OptimizerException, "Lookup before the index was built.");
+		Bucket const& bucket = m_buckets[uint8_t(_instruction)];
+		size_t key = 0;
+		for (size_t i = 0; i < bucket.shapes.size(); ++i)
+		{
+			std::vector<unsigned> const& shapes = bucket.shapes[i];
+			// Shapes that are not required by any pattern (and missing arguments) map to shapes.size().
+			size_t shapeIndex = shapes.size();
+			if (i < _arguments)
+				shapeIndex = size_t(std::find(shapes.begin(), shapes.end(), _argumentShape(i)) - shapes.begin());
+			key = key * (shapes.size() + 1) + shapeIndex;
+		}
+		return bucket.candidates[key];
+	}
+
+private:
+	struct Bucket
+	{
+		std::vector<Rule> rules;
+		/// Shapes required by some pattern for each argument position.
+		std::vector<std::vector<unsigned>> shapes;
+		/// Compatible rules for each combination of shapes (indexed by the key computed in candidates).
+		std::vector<std::vector<Rule const*>> candidates;
+
+		void build()
+		{
+			for (Rule const& rule: rules)
+			{
+				std::vector<Pattern> const& arguments = rule.pattern.arguments();
+				if (shapes.size() < arguments.size())
+					shapes.resize(arguments.size());
+				for (size_t i = 0; i < arguments.size(); ++i)
+					if (std::optional<unsigned> shape = arguments[i].shape())
+						if (std::find(shapes[i].begin(), shapes[i].end(), *shape) == shapes[i].end())
+							shapes[i].push_back(*shape);
+			}
+
+			size_t combinations = 1;
+			for (auto const& positionShapes: shapes)
+			{
+				combinations *= positionShapes.size() + 1;
+				assertThrow(combinations <= c_maxCombinations, OptimizerException, "Too many rule shapes.");
+			}
+			candidates.resize(combinations);
+			for (size_t key = 0; key < combinations; ++key)
+				for (Rule const& rule: rules)
+					if (compatible(rule, key))
+						candidates[key].push_back(&rule);
+		}
+
+		bool compatible(Rule const& _rule, size_t _key) const
+		{
+			std::vector<Pattern> const& arguments = _rule.pattern.arguments();
+			// The key is decoded starting with the last argument position.
+			for (size_t i = shapes.size(); i-- > 0;)
+			{
+				size_t shapeIndex = _key % (shapes[i].size() + 1);
+				_key /= shapes[i].size() + 1;
+				if (i < arguments.size())
+					if (std::optional<unsigned> shape = arguments[i].shape())
+						if (shapeIndex == shapes[i].size() || shapes[i][shapeIndex] != *shape)
+							return false;
+			}
+			return true;
+		}
+	};
+
+	static size_t constexpr c_maxCombinations = 0x10000;
+
+	Bucket m_buckets[256];
+	bool m_built = false;
+};
+
 struct EVMBuiltins
 {
 	using InstrType = Instruction;
@@ -43,16 +43,17 @@ using namespace langutil;
 SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	Expression const& _expr,
 	ExpressionClasses const& _classes
-)
+) const
 {
 	resetMatchGroups();
 
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
+	auto argumentShape = [&](size_t _i) { return Pattern::shape(_classes.representative(_expr.arguments[_i])); };
+	for (auto const* rule: m_rules.candidates(_expr.item->instruction(), _expr.arguments.size(), argumentShape))
 	{
-		if (rule.pattern.matches(_expr, _classes))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
+		if (rule->pattern.matches(_expr, _classes))
+			if (!rule->feasible || rule->feasible())
+				return rule;
 
 		resetMatchGroups();
 	}
@@ -61,7 +62,7 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 
 bool Rules::isInitialized() const
 {
-	return !m_rules[uint8_t(Instruction::ADD)].empty();
+	return !m_rules.empty(Instruction::ADD);
 }
 
 void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
@@ -72,7 +73,7 @@ void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
 
 void Rules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	m_rules.add(_rule);
 }
 
 Rules::Rules()
@@ -96,6 +97,7 @@ Rules::Rules()
 	Z.setMatchGroup(7, m_matchGroups);
 
 	addRules(simplificationRuleList(A, B, C, W, X, Y, Z));
+	m_rules.build();
 	assertThrow(isInitialized(), OptimizerException, "Rule list not properly initialized.");
 }
 
@@ -106,7 +108,7 @@ Pattern::Pattern(Instruction _instruction, std::vector<Pattern> const& _argument
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, MatchGroups<Expression>& _matchGroups)
 {
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
@@ -130,6 +132,27 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 	return true;
 }
 
+optional<unsigned> Pattern::shape() const
+{
+	if (m_type == Operation)
+		return unsigned(m_instruction);
+	else if (m_type == Push)
+		return SimplificationRuleIndex<Pattern>::constantShape;
+	// Other item types are rare, do not bother restricting them.
+	return nullopt;
+}
+
+unsigned Pattern::shape(Expression const& _expr)
+{
+	if (!_expr.item)
+		return SimplificationRuleIndex<Pattern>::otherShape;
+	else if (_expr.item->type() == Operation)
+		return unsigned(_expr.item->instruction());
+	else if (_expr.item->type() == Push)
+		return SimplificationRuleIndex<Pattern>::constantShape;
+	return SimplificationRuleIndex<Pattern>::otherShape;
+}
+
 AssemblyItem Pattern::toAssemblyItem(SourceLocation const& _location) const
 {
 	if (m_type == Operation)
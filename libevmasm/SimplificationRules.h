@@ -45,6 +45,8 @@ class Pattern;
 
 /**
  * Container for all simplification rules.
+ * The rules can be used by several threads at the same time, since their match groups are
+ * thread-local.
  */
 class Rules: public boost::noncopyable
 {
@@ -54,11 +56,11 @@ public:
 	Rules();
 
 	/// @returns a pointer to the first matching pattern and sets the match
-	/// groups accordingly.
+	/// groups of the current thread accordingly.
 	SimplificationRule<Pattern> const* findFirstMatch(
 		Expression const& _expr,
 		ExpressionClasses const& _classes
-	);
+	) const;
 
 	/// Checks whether the rulelist is non-empty. This is usually enforced
 	/// by the constructor, but we had some issues with static initialization.
@@ -68,12 +70,12 @@ private:
 	void addRules(std::vector<SimplificationRule<Pattern>> const& _rules);
 	void addRule(SimplificationRule<Pattern> const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	void resetMatchGroups() const { m_matchGroups.clear(); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
+	mutable MatchGroups<Expression> m_matchGroups{true};
 	/// Pattern to match, replacement to be applied and flag indicating whether
 	/// the replacement might remove some elements (except constants).
-	std::vector<SimplificationRule<Pattern>> m_rules[256];
+	SimplificationRuleIndex<Pattern> m_rules;
 };
 
 /**
@@ -102,12 +104,12 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, MatchGroups<Expression>& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(Expression const& _expr, ExpressionClasses const& _classes) const;
 
 	AssemblyItem toAssemblyItem(langutil::SourceLocation const& _location) const;
-	std::vector<Pattern> arguments() const { return m_arguments; }
+	std::vector<Pattern> const& arguments() const { return m_arguments; }
 
 	/// @returns the id of the matched expression if this pattern is part of a match group.
 	Id id() const { return matchGroupValue().id; }
@@ -116,6 +118,12 @@ public:
 
 	std::string toString() const;
 
+	/// @returns the shape of the expressions this pattern can match (see SimplificationRuleIndex)
+	/// or nullopt if it is not restricted to a single shape.
+	std::optional<unsigned> shape() const;
+	/// @returns the shape of the expression @a _expr.
+	static unsigned shape(Expression const& _expr);
+
 	AssemblyItemType type() const { return m_type; }
 	Instruction instruction() const
 	{
@@ -134,7 +142,7 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_type is not Operation
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	MatchGroups<Expression>* m_matchGroups = nullptr;
 };
 
 /**
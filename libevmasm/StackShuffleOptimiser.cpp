@@ -0,0 +1,251 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Replaces runs of stack shuffling instructions by shortest equivalent runs.
+ */
+
+#include <libevmasm/StackShuffleOptimiser.h>
+
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <libdevcore/CommonData.h>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <mutex>
+#include <set>
+#include <tuple>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+
+/// Maximum length of the sequences that are searched for.
+size_t const c_maxSequenceLength = 10;
+/// Maximum number of stack layouts visited in a single search.
+size_t const c_maxVisitedLayouts = 20000;
+/// Runs that access deeper elements than this are not optimised.
+size_t const c_maxDepth = 32;
+
+/// Top part of the stack, each element is identified by its position at the start of the run.
+/// The top of the stack is the last element.
+using Layout = vector<uint8_t>;
+
+bool isShuffle(AssemblyItem const& _item)
+{
+	return
+		SemanticInformation::isDupInstruction(_item) ||
+		SemanticInformation::isSwapInstruction(_item) ||
+		_item == AssemblyItem(Instruction::POP);
+}
+
+/// Applies @a _instruction to @a _layout.
+/// @returns false if it would access an element that is not part of the layout.
+bool apply(Instruction _instruction, Layout& _layout)
+{
+	if (_instruction == Instruction::POP)
+	{
+		if (_layout.empty())
+			return false;
+		_layout.pop_back();
+	}
+	else if (isDupInstruction(_instruction))
+	{
+		size_t n = getDupNumber(_instruction);
+		if (n > _layout.size())
+			return false;
+		_layout.push_back(_layout[_layout.size() - n]);
+	}
+	else
+	{
+		size_t n = getSwapNumber(_instruction);
+		if (n >= _layout.size())
+			return false;
+		swap(_layout.back(), _layout[_layout.size() - 1 - n]);
+	}
+	return true;
+}
+
+/// @returns the number of elements @a _shuffle accesses below the initial stack top.
+size_t requiredDepth(vector<Instruction> const& _shuffle)
+{
+	int height = 0;
+	int depth = 0;
+	for (Instruction instruction: _shuffle)
+	{
+		InstructionInfo info = instructionInfo(instruction);
+		depth = max(depth, info.args - height);
+		height += info.ret - info.args;
+	}
+	return size_t(depth);
+}
+
+bool containsAll(Layout const& _layout, Layout const& _elements)
+{
+	array<unsigned, 256> available{};
+	for (uint8_t element: _layout)
+		available[element]++;
+	for (uint8_t element: _elements)
+		if (!available[element])
+			return false;
+	return true;
+}
+
+unsigned gas(vector<Instruction> const& _sequence)
+{
+	unsigned result = 0;
+	for (Instruction instruction: _sequence)
+		result += GasMeter::runGas(instruction);
+	return result;
+}
+
+/// Breadth-first search for the cheapest among the shortest sequences turning @a _initial into
+/// @a _target without growing beyond @a _maxHeight elements.
+optional<vector<Instruction>> search(Layout const& _initial, Layout const& _target, size_t _maxHeight)
+{
+	if (_initial == _target)
+		return vector<Instruction>{};
+
+	vector<Instruction> moves{Instruction::POP};
+	for (unsigned i = 1; i <= 16; ++i)
+	{
+		moves.push_back(dupInstruction(i));
+		moves.push_back(swapInstruction(i));
+	}
+
+	set<Layout> visited{_initial};
+	map<Layout, pair<unsigned, vector<Instruction>>> level{{_initial, {0, {}}}};
+	for (size_t length = 1; length <= c_maxSequenceLength && !level.empty(); ++length)
+	{
+		map<Layout, pair<unsigned, vector<Instruction>>> nextLevel;
+		for (auto const& [layout, path]: level)
+			for (Instruction instruction: moves)
+			{
+				Layout next = layout;
+				if (!apply(instruction, next) || next.size() > _maxHeight || visited.count(next))
+					continue;
+				// Elements that are gone cannot be recovered.
+				if (!containsAll(next, _target))
+					continue;
+				unsigned nextGas = path.first + GasMeter::runGas(instruction);
+				auto it = nextLevel.find(next);
+				if (it == nextLevel.end() || nextGas < it->second.first)
+					nextLevel[next] = {nextGas, path.second + vector<Instruction>{instruction}};
+			}
+		if (nextLevel.count(_target))
+			return nextLevel.at(_target).second;
+		for (auto const& entry: nextLevel)
+			visited.insert(entry.first);
+		if (visited.size() > c_maxVisitedLayouts)
+			break;
+		level = move(nextLevel);
+	}
+	return nullopt;
+}
+
+mutex& cacheMutex()
+{
+	static mutex s_mutex;
+	return s_mutex;
+}
+
+/// Results of previous searches, by initial depth, maximum height and target layout.
+map<tuple<size_t, size_t, Layout>, optional<vector<Instruction>>>& cache()
+{
+	static map<tuple<size_t, size_t, Layout>, optional<vector<Instruction>>> s_cache;
+	return s_cache;
+}
+
+}
+
+optional<vector<Instruction>> StackShuffleOptimiser::bestSequence(vector<Instruction> const& _shuffle)
+{
+	size_t depth = requiredDepth(_shuffle);
+	if (depth > c_maxDepth)
+		return nullopt;
+
+	Layout initial(depth);
+	for (size_t i = 0; i < depth; ++i)
+		initial[i] = uint8_t(i);
+	Layout target = initial;
+	size_t maxHeight = depth;
+	for (Instruction instruction: _shuffle)
+	{
+		bool applied = apply(instruction, target);
+		assertThrow(applied, OptimizerException, "Invalid stack shuffle.");
+		maxHeight = max(maxHeight, target.size());
+	}
+
+	auto key = make_tuple(depth, maxHeight, target);
+	{
+		lock_guard<mutex> lock(cacheMutex());
+		if (cache().count(key))
+			return cache().at(key);
+	}
+	optional<vector<Instruction>> result = search(initial, target, maxHeight);
+	lock_guard<mutex> lock(cacheMutex());
+	if (cache().size() < c_maxCacheEntries)
+		cache().emplace(key, result);
+	return result;
+}
+
+void StackShuffleOptimiser::clearCache()
+{
+	lock_guard<mutex> lock(cacheMutex());
+	cache().clear();
+}
+
+bool StackShuffleOptimiser::optimise()
+{
+	bool optimised = false;
+	AssemblyItems items;
+	for (auto it = m_items.begin(); it != m_items.end();)
+	{
+		auto end = find_if_not(it, m_items.end(), isShuffle);
+		if (end == it)
+		{
+			items.push_back(*it++);
+			continue;
+		}
+
+		vector<Instruction> shuffle;
+		for (auto shuffleIt = it; shuffleIt != end; ++shuffleIt)
+			shuffle.push_back(shuffleIt->instruction());
+		optional<vector<Instruction>> best = bestSequence(shuffle);
+		if (best && (
+			best->size() < shuffle.size() ||
+			(best->size() == shuffle.size() && gas(*best) < gas(shuffle))
+		))
+		{
+			for (Instruction instruction: *best)
+				items.emplace_back(instruction, it->location());
+			optimised = true;
+		}
+		else
+			copy(it, end, back_inserter(items));
+		it = end;
+	}
+	if (optimised)
+		m_items = move(items);
+	return optimised;
+}
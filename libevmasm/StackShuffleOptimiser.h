@@ -0,0 +1,67 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Replaces runs of stack shuffling instructions by shortest equivalent runs.
+ */
+#pragma once
+
+#include <libevmasm/Instruction.h>
+
+#include <optional>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+class AssemblyItem;
+using AssemblyItems = std::vector<AssemblyItem>;
+
+/**
+ * Optimisation stage that replaces each maximal run of DUP, SWAP and POP instructions
+ * by the shortest (and among those the cheapest) run of such instructions that has the
+ * same effect on the stack, found by an exhaustive breadth-first search.
+ * The searches are bounded in length and number of visited stack layouts, and their results
+ * are cached process-wide (up to a bounded number of entries), so that each distinct shuffle
+ * is only searched for once.
+ */
+class StackShuffleOptimiser
+{
+public:
+	explicit StackShuffleOptimiser(AssemblyItems& _items): m_items(_items) {}
+
+	/// @returns true if any run was replaced.
+	bool optimise();
+
+	/// @returns a shortest and cheapest sequence of DUP, SWAP and POP instructions that has the
+	/// same effect on the stack as @a _shuffle (which has to consist of such instructions only),
+	/// does not access deeper stack elements and does not grow the stack higher, or nullopt if
+	/// no such sequence was found within the search bounds.
+	static std::optional<std::vector<Instruction>> bestSequence(std::vector<Instruction> const& _shuffle);
+
+	/// Removes all cached search results.
+	static void clearCache();
+
+private:
+	/// Maximum number of cached search results, further results are not stored.
+	static size_t constexpr c_maxCacheEntries = 0x4000;
+
+	AssemblyItems& m_items;
+};
+
+}
+}
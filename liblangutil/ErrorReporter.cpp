@@ -22,6 +22,7 @@
 
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/SourceLocation.h>
+#include <algorithm>
 #include <memory>
 
 using namespace std;
@@ -143,6 +144,25 @@ ErrorList const& ErrorReporter::errors() const
 void ErrorReporter::clear()
 {
 	m_errorList.clear();
+	m_errorCount = 0;
+	m_warningCount = 0;
+}
+
+void ErrorReporter::removeErrors(function<bool(Error const&)> const& _predicate)
+{
+	m_errorList.erase(
+		remove_if(m_errorList.begin(), m_errorList.end(), [&](shared_ptr<Error const> const& _error) {
+			return _predicate(*_error);
+		}),
+		m_errorList.end()
+	);
+	m_errorCount = 0;
+	m_warningCount = 0;
+	for (auto const& error: m_errorList)
+		if (error->type() == Error::Type::Warning)
+			m_warningCount++;
+		else
+			m_errorCount++;
 }
 
 void ErrorReporter::declarationError(SourceLocation const& _location, SecondarySourceLocation const& _secondaryLocation, string const& _description)
@@ -30,6 +30,8 @@
 
 #include <boost/range/adaptor/filtered.hpp>
 
+#include <functional>
+
 namespace langutil
 {
 
@@ -112,6 +114,11 @@ public:
 
 	void clear();
 
+	/// Removes all errors for which @a _predicate returns true. Errors that were ignored because
+	/// of too many warnings or errors are not reported again, but later ones are counted as if
+	/// the removed errors had never been reported.
+	void removeErrors(std::function<bool(Error const&)> const& _predicate);
+
 	/// @returns true iff there is any error (ignores warnings).
 	bool hasErrors() const
 	{
@@ -35,7 +35,7 @@ namespace dev
 namespace solidity
 {
 
-inline vector<shared_ptr<MagicVariableDeclaration const>> constructMagicVariables()
+inline vector<shared_ptr<MagicVariableDeclaration>> constructMagicVariables()
 {
 	static auto const magicVarDecl = [](string const& _name, Type const* _type) {
 		return make_shared<MagicVariableDeclaration>(_name, _type);
@@ -111,5 +111,20 @@ MagicVariableDeclaration const* GlobalContext::currentSuper() const
 	return m_superPointer[m_currentContract].get();
 }
 
+void GlobalContext::resetIDs(size_t _lastID, vector<ContractDefinition const*> const& _contracts)
+{
+	for (auto const& variable: m_magicVariables)
+		variable->setID(++_lastID);
+	for (ContractDefinition const* contract: _contracts)
+	{
+		setCurrentContract(*contract);
+		currentThis();
+		currentSuper();
+		m_thisPointer[contract]->setID(++_lastID);
+		m_superPointer[contract]->setID(++_lastID);
+	}
+	ASTNode::resetID(_lastID);
+}
+
 }
 }
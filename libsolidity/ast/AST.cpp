@@ -39,7 +39,7 @@ class IDDispenser
 {
 public:
 	static size_t next() { return ++instance(); }
-	static void reset() { instance() = 0; }
+	static void reset(size_t _lastID) { instance() = _lastID; }
 private:
 	static size_t& instance()
 	{
@@ -60,9 +60,9 @@ ASTNode::~ASTNode()
 	delete m_annotation;
 }
 
-void ASTNode::resetID()
+void ASTNode::resetID(size_t _lastID)
 {
-	IDDispenser::reset();
+	IDDispenser::reset(_lastID);
 }
 
 ASTAnnotation& ASTNode::annotation() const
@@ -71,8 +71,9 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	size_t id() const { return m_id; }
-	/// Resets the global ID counter. This invalidates all previous IDs.
-	static void resetID();
+	/// Resets the global ID counter, the next node gets the ID @a _lastID + 1.
+	/// Resetting it to zero invalidates all previous IDs.
+	static void resetID(size_t _lastID = 0);
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -109,7 +110,7 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
 	mutable ASTAnnotation* m_annotation = nullptr;
 
@@ -884,6 +885,10 @@ public:
 	}
 	TypePointer type() const override { return m_type; }
 
+	/// Magic variables are not part of any source, so they can get a different ID
+	/// when the sources are updated (see GlobalContext::resetIDs).
+	void setID(size_t _id) { m_id = _id; }
+
 private:
 	Type const* m_type;
 };
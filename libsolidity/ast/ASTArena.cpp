@@ -0,0 +1,58 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Bump allocator for AST nodes.
+ */
+
+#include <libsolidity/ast/ASTArena.h>
+
+#include <liblangutil/Exceptions.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+void* ASTArena::allocate(size_t _size, size_t _alignment)
+{
+	solAssert(_alignment > 0 && (_alignment & (_alignment - 1)) == 0, "Invalid alignment.");
+	m_allocatedBytes += _size;
+
+	size_t padding = (_alignment - reinterpret_cast<uintptr_t>(m_current) % _alignment) % _alignment;
+	if (m_current && padding + _size <= m_remaining)
+	{
+		char* result = m_current + padding;
+		m_current = result + _size;
+		m_remaining -= padding + _size;
+		return result;
+	}
+
+	// Allocations that do not fit into a regular block get a block of their own,
+	// so that the free space of the current block is not wasted.
+	// Blocks come from operator new[] and are thus suitably aligned for all fundamental types.
+	solAssert(_alignment <= alignof(max_align_t), "Over-aligned AST node.");
+	if (_size > c_blockSize / 4)
+	{
+		m_blocks.emplace_back(new char[_size]);
+		return m_blocks.back().get();
+	}
+
+	m_blocks.emplace_back(new char[c_blockSize]);
+	char* result = m_blocks.back().get();
+	m_current = result + _size;
+	m_remaining = c_blockSize - _size;
+	return result;
+}
@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Bump allocator for AST nodes.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Region of memory that AST nodes are allocated from consecutively.
+ * Memory is only released when the arena itself is destroyed, which happens
+ * once the last node allocated from it (each of them holds a reference) is gone.
+ */
+class ASTArena: boost::noncopyable
+{
+public:
+	/// @returns a pointer to @a _size bytes aligned to @a _alignment.
+	void* allocate(size_t _size, size_t _alignment);
+
+	/// @returns the number of bytes handed out so far.
+	size_t allocatedBytes() const { return m_allocatedBytes; }
+
+private:
+	static size_t constexpr c_blockSize = 64 * 1024;
+
+	std::vector<std::unique_ptr<char[]>> m_blocks;
+	/// Free space in the most recently allocated block.
+	char* m_current = nullptr;
+	size_t m_remaining = 0;
+	size_t m_allocatedBytes = 0;
+};
+
+/**
+ * Standard allocator handing out memory from an ASTArena, to be used with
+ * std::allocate_shared. Deallocation is a no-op, the memory is reclaimed with the arena.
+ */
+template <class T>
+class ASTArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ASTArenaAllocator(std::shared_ptr<ASTArena> _arena): m_arena(std::move(_arena)) {}
+	template <class U>
+	ASTArenaAllocator(ASTArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _count) { return static_cast<T*>(m_arena->allocate(sizeof(T) * _count, alignof(T))); }
+	void deallocate(T*, size_t) noexcept {}
+
+	std::shared_ptr<ASTArena> const& arena() const { return m_arena; }
+
+	template <class U>
+	bool operator==(ASTArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <class U>
+	bool operator!=(ASTArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<ASTArena> m_arena;
+};
+
+}
+}
@@ -27,12 +27,17 @@
 #include <libsolidity/codegen/CompilerUtils.h>
 #include <libsolidity/interface/Version.h>
 
+#include <libevmasm/ConstantOptimiser.h>
+#include <libevmasm/StackShuffleOptimiser.h>
+
 #include <libyul/AsmParser.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmPrinter.h>
 #include <libyul/backends/evm/AsmCodeGen.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Suite.h>
 #include <libyul/Object.h>
 #include <libyul/YulString.h>
@@ -41,16 +46,16 @@
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <libdevcore/Keccak256.h>
+
 #include <boost/algorithm/string/replace.hpp>
 
+#include <mutex>
 #include <utility>
 #include <numeric>
 
 // Change to "define" to output all intermediate code
 #undef SOL_OUTPUT_ASM
-#ifdef SOL_OUTPUT_ASM
-#include <libyul/AsmPrinter.h>
-#endif
 
 
 using namespace std;
@@ -59,6 +64,116 @@ using namespace dev::eth;
 using namespace dev;
 using namespace dev::solidity;
 
+namespace
+{
+
+/// Cache for the results of optimising inline assembly generated by the code generator.
+/// Many contracts use the same set of ABI coder routines, which only need to be optimised once.
+/// The cached code refers to YulStrings, so the cache is cleared together with their repository.
+class OptimisedAssemblyCache
+{
+public:
+	static OptimisedAssemblyCache& instance()
+	{
+		static OptimisedAssemblyCache cache;
+		static yul::YulStringRepository::ResetCallback callback{[&] { cache.clear(); }};
+		return cache;
+	}
+
+	/// @returns a copy of the code stored under @a _key or nullptr if there is none.
+	shared_ptr<yul::Block> find(h256 const& _key)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_entries.find(_key);
+		if (it == m_entries.end())
+			return nullptr;
+		return make_shared<yul::Block>(boost::get<yul::Block>(yul::ASTCopier{}(*it->second)));
+	}
+
+	void store(h256 const& _key, yul::Block const& _code)
+	{
+		auto copy = make_shared<yul::Block>(boost::get<yul::Block>(yul::ASTCopier{}(_code)));
+		lock_guard<mutex> lock(m_mutex);
+		if (m_entries.size() < c_maxEntries)
+			m_entries[_key] = move(copy);
+	}
+
+	void clear()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_entries.clear();
+	}
+
+private:
+	/// Maximum number of entries, further entries are not stored.
+	static size_t constexpr c_maxEntries = 0x100;
+
+	mutex m_mutex;
+	map<h256, shared_ptr<yul::Block const>> m_entries;
+};
+
+/// Copies Yul code and replaces the numbers following "_$" in identifiers, i.e. the AST IDs in
+/// the names of the routines generated for types (and the lengths of static arrays), by the
+/// index of their first occurrence. Used the other way round, it restores the original numbers.
+/// This way, the same routines generated in different contracts or compilations share an
+/// entry in the cache and their optimisation does not depend on the AST IDs.
+class ASTIDNormaliser: public yul::ASTCopier
+{
+public:
+	ASTIDNormaliser() = default;
+	/// Restores the numbers @a _ids, which were replaced by their index.
+	explicit ASTIDNormaliser(vector<string> _ids): m_ids(move(_ids)), m_restore(true) {}
+
+	using ASTCopier::operator();
+
+	yul::YulString normalise(yul::YulString _name) { return translateIdentifier(_name); }
+	/// @returns the replaced numbers by their index.
+	vector<string> const& ids() const { return m_ids; }
+
+protected:
+	yul::YulString translateIdentifier(yul::YulString _name) override
+	{
+		string const& name = _name.str();
+		if (name.find("_$") == string::npos)
+			return _name;
+		string result;
+		size_t position = 0;
+		for (size_t start = name.find("_$"); start != string::npos; start = name.find("_$", position))
+		{
+			start += 2;
+			size_t end = start;
+			while (end < name.size() && isdigit(name[end]))
+				end++;
+			result += name.substr(position, start - position);
+			if (end > start)
+				result += translateID(name.substr(start, end - start));
+			position = end;
+		}
+		result += name.substr(position);
+		return yul::YulString{result};
+	}
+
+private:
+	string translateID(string const& _id)
+	{
+		if (m_restore)
+		{
+			size_t index = stoul(_id);
+			solAssert(index < m_ids.size(), "");
+			return m_ids[index];
+		}
+		auto it = find(m_ids.begin(), m_ids.end(), _id);
+		if (it == m_ids.end())
+			it = m_ids.insert(m_ids.end(), _id);
+		return to_string(it - m_ids.begin());
+	}
+
+	vector<string> m_ids;
+	bool m_restore = false;
+};
+
+}
+
 void CompilerContext::addStateVariable(
 	VariableDeclaration const& _declaration,
 	u256 const& _storageOffset,
@@ -423,18 +538,45 @@ void CompilerContext::appendInlineAssembly(
 	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
 	{
 		bool const isCreation = m_runtimeContext != nullptr;
-		yul::GasMeter meter(dialect, isCreation, _optimiserSettings.expectedExecutionsPerDeployment);
+		// The code is optimised with normalised AST IDs in the names of the routines.
+		ASTIDNormaliser normaliser;
 		yul::Object obj;
-		obj.code = parserResult;
-		obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(analysisInfo);
-		yul::OptimiserSuite::run(
-			dialect,
-			&meter,
-			obj,
-			_optimiserSettings.optimizeStackAllocation,
-			externallyUsedIdentifiers
-		);
-		analysisInfo = std::move(*obj.analysisInfo);
+		obj.code = make_shared<yul::Block>(boost::get<yul::Block>(normaliser(*parserResult)));
+		set<yul::YulString> normalisedExternallyUsedIdentifiers;
+		for (auto const& identifier: externallyUsedIdentifiers)
+			normalisedExternallyUsedIdentifiers.insert(normaliser.normalise(identifier));
+
+		// The key has to cover everything the result of the optimiser depends on.
+		string cacheKey = yul::AsmPrinter{}(*obj.code);
+		for (auto const& identifier: normalisedExternallyUsedIdentifiers)
+			cacheKey += "\n" + identifier.str();
+		cacheKey +=
+			"\n" + m_evmVersion.name() +
+			"\n" + to_string(isCreation) +
+			"\n" + to_string(_optimiserSettings.expectedExecutionsPerDeployment) +
+			"\n" + to_string(_optimiserSettings.optimizeStackAllocation) +
+			"\n" + _optimiserSettings.yulOptimiserSteps;
+		h256 cacheKeyHash = keccak256(cacheKey);
+
+		if (shared_ptr<yul::Block> cachedCode = OptimisedAssemblyCache::instance().find(cacheKeyHash))
+			obj.code = move(cachedCode);
+		else
+		{
+			yul::GasMeter meter(dialect, isCreation, _optimiserSettings.expectedExecutionsPerDeployment);
+			obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj));
+			yul::OptimiserSuite::run(
+				dialect,
+				&meter,
+				obj,
+				_optimiserSettings.optimizeStackAllocation,
+				normalisedExternallyUsedIdentifiers,
+				nullptr,
+				_optimiserSettings.yulOptimiserSteps
+			);
+			OptimisedAssemblyCache::instance().store(cacheKeyHash, *obj.code);
+		}
+		obj.code = make_shared<yul::Block>(boost::get<yul::Block>(ASTIDNormaliser{normaliser.ids()}(*obj.code)));
+		analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
 		parserResult = std::move(obj.code);
 
 #ifdef SOL_OUTPUT_ASM
@@ -494,16 +636,26 @@ void CompilerContext::updateSourceLocation()
 	m_asm->setSourceLocation(m_visitedNodes.empty() ? SourceLocation() : m_visitedNodes.top()->location());
 }
 
+void CompilerContext::optimise(OptimiserSettings const& _settings)
+{
+	// The constant optimiser and the stack shuffle optimiser cache their results across contracts,
+	// clear them together with the other caches between the compilations of a long-running process.
+	static yul::YulStringRepository::ResetCallback constantCacheCallback{[] { eth::ConstantRepresentationCache::clear(); }};
+	static yul::YulStringRepository::ResetCallback stackShuffleCacheCallback{[] { eth::StackShuffleOptimiser::clearCache(); }};
+	m_asm->optimise(translateOptimiserSettings(_settings));
+}
+
 eth::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	eth::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0};
+	eth::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, false, m_evmVersion, 0};
 	asmSettings.isCreation = true;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
 	asmSettings.runCSE = _settings.runCSE;
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
+	asmSettings.runStackShuffle = _settings.runStackShuffle;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
 	asmSettings.evmVersion = m_evmVersion;
 	return asmSettings;
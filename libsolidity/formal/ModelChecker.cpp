@@ -29,13 +29,22 @@ ModelChecker::ModelChecker(ErrorReporter& _errorReporter, map<h256, string> cons
 {
 }
 
-void ModelChecker::analyze(SourceUnit const& _source)
+vector<string> ModelChecker::analyze(SourceUnit const& _source)
 {
 	if (!_source.annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker))
-		return;
+		return {};
 
+	// The unhandled queries of both engines only grow, the new ones are at their ends.
+	size_t bmcQueries = m_bmc.unhandledQueries().size();
+	size_t chcQueries = m_chc.unhandledQueries().size();
 	m_chc.analyze(_source);
 	m_bmc.analyze(_source, m_chc.safeAssertions());
+
+	vector<string> bmcUnhandled = m_bmc.unhandledQueries();
+	vector<string> chcUnhandled = m_chc.unhandledQueries();
+	return
+		vector<string>(bmcUnhandled.begin() + bmcQueries, bmcUnhandled.end()) +
+		vector<string>(chcUnhandled.begin() + chcQueries, chcUnhandled.end());
 }
 
 vector<string> ModelChecker::unhandledQueries()
@@ -45,7 +45,8 @@ class ModelChecker
 public:
 	ModelChecker(langutil::ErrorReporter& _errorReporter, std::map<h256, std::string> const& _smtlib2Responses);
 
-	void analyze(SourceUnit const& _sources);
+	/// Analyzes @a _source and @returns the unhandled queries (see below) added for it.
+	std::vector<std::string> analyze(SourceUnit const& _source);
 
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Persistent, content-addressed cache for compiler outputs.
+ */
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace fs = boost::filesystem;
+
+optional<Json::Value> CompilationCache::load(h256 const& _key) const
+{
+	fs::path path = entryPath(_key);
+	boost::system::error_code error;
+	if (!fs::is_regular_file(path, error))
+		return nullopt;
+
+	Json::Value value;
+	if (!jsonParseStrict(readFileAsString(path.string()), value))
+		return nullopt;
+	return value;
+}
+
+void CompilationCache::store(h256 const& _key, Json::Value const& _value) const
+{
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	// Write to a temporary file first and rename it afterwards, so that concurrent
+	// readers never see partially written entries.
+	fs::path temporary = m_directory / fs::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+	{
+		ofstream file(temporary.string(), ios::binary);
+		file << jsonCompactPrint(_value);
+		if (!file)
+		{
+			fs::remove(temporary, error);
+			return;
+		}
+	}
+	fs::rename(temporary, entryPath(_key), error);
+	if (error)
+		fs::remove(temporary, error);
+}
+
+fs::path CompilationCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
@@ -0,0 +1,59 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Persistent, content-addressed cache for compiler outputs.
+ */
+
+#pragma once
+
+#include <libdevcore/FixedHash.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <optional>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Directory-based cache that maps keys (hashes of everything an output depends on)
+ * to JSON values. Entries are never invalidated, since a different input always
+ * results in a different key.
+ * The cache is best-effort: Failures to read or write entries are treated as cache misses.
+ */
+class CompilationCache
+{
+public:
+	explicit CompilationCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the value stored under @a _key, if present.
+	std::optional<Json::Value> load(h256 const& _key) const;
+	/// Stores @a _value under @a _key, replacing any previous value.
+	void store(h256 const& _key, Json::Value const& _value) const;
+
+private:
+	boost::filesystem::path entryPath(h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
+}
@@ -64,6 +64,7 @@
 #include <libdevcore/SwarmHash.h>
 #include <libdevcore/IpfsHash.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/Profiler.h>
 
 #include <json/json.h>
 
@@ -171,6 +172,10 @@ void CompilerStack::reset(bool _keepSettings)
 	m_stackState = Empty;
 	m_hasError = false;
 	m_sources.clear();
+	m_sourcesToUpdate.clear();
+	m_parseOrder.clear();
+	m_replacedASTs.clear();
+	m_astArena.reset();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
 	if (!_keepSettings)
@@ -202,45 +207,227 @@ void CompilerStack::setSources(StringMap _sources)
 	m_stackState = SourcesSet;
 }
 
+void CompilerStack::updateSources(StringMap _sources)
+{
+	if (m_stackState == Empty)
+	{
+		setSources(move(_sources));
+		return;
+	}
+	if (m_stackState == SourcesSet)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot update sources before parsing."));
+
+	// Sources that were only imported before are parsed at a different position once they
+	// are given directly, so they count as changed.
+	StringMap changedSources;
+	for (auto& [name, content]: _sources)
+		if (!m_sources.count(name) || m_sources.at(name).imported || m_sources.at(name).scanner->source() != content)
+			changedSources[name] = move(content);
+	if (changedSources.empty())
+		return;
+
+	// Without a successful analysis, the annotations of the unchanged sources cannot be re-used.
+	// The replaced ASTs are also dropped from time to time, since they are kept alive until the next reset.
+	if (m_stackState < AnalysisPerformed || m_hasError || m_replacedASTs.size() > m_sources.size())
+	{
+		StringMap sources;
+		for (auto const& [name, source]: m_sources)
+			if (!source.imported)
+				sources[name] = source.scanner->source();
+		for (auto& [name, content]: changedSources)
+			sources[name] = move(content);
+		map<h256, string> smtlib2Responses = move(m_smtlib2Responses);
+		reset(true);
+		m_smtlib2Responses = move(smtlib2Responses);
+		setSources(move(sources));
+		return;
+	}
+
+	m_sourcesToUpdate.clear();
+	for (auto& [name, content]: changedSources)
+	{
+		Source& source = m_sources[name];
+		if (source.ast)
+			m_replacedASTs.emplace_back(move(source.ast));
+		source.reset();
+		source.scanner = make_shared<Scanner>(CharStream(move(content), name));
+		m_sourcesToUpdate.insert(name);
+	}
+	m_stackState = SourcesSet;
+}
+
 bool CompilerStack::parse()
 {
 	if (m_stackState != SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call parse only after the SourcesSet state."));
-	m_errorReporter.clear();
-	ASTNode::resetID();
+	bool const update = !m_sourcesToUpdate.empty();
+	if (!update)
+	{
+		m_errorReporter.clear();
+		ASTNode::resetID();
 
-	if (SemVerVersion{string(VersionString)}.isPrerelease())
-		m_errorReporter.warning("This is a pre-release compiler version, please do not use it in production.");
+		if (SemVerVersion{string(VersionString)}.isPrerelease())
+			m_errorReporter.warning("This is a pre-release compiler version, please do not use it in production.");
 
-	if (m_optimiserSettings.runYulOptimiser)
-		m_errorReporter.warning(
-			"The Yul optimiser is still experimental. "
-			"Do not use it in production unless correctness of generated code is verified with extensive tests."
-		);
+		if (m_optimiserSettings.runYulOptimiser)
+			m_errorReporter.warning(
+				"The Yul optimiser is still experimental. "
+				"Do not use it in production unless correctness of generated code is verified with extensive tests."
+			);
+		m_generalWarnings = m_errorList.size();
+	}
+	size_t const previousErrors = m_errorList.size();
 
-	vector<string> sourcesToParse;
-	for (auto const& s: m_sources)
-		sourcesToParse.push_back(s.first);
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+	if (m_useASTArena && !m_astArena)
+		m_astArena = make_shared<ASTArena>();
+
+	set<string> parsedSources;
+	auto parseSource = [&](string const& _path)
 	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
+		Source& source = m_sources[_path];
+		if (source.ast)
+			m_replacedASTs.emplace_back(move(source.ast));
 		source.scanner->reset();
-		source.ast = Parser(m_errorReporter, m_evmVersion, m_parserErrorRecovery).parse(source.scanner);
+		ScopedProfile profile("Parser");
+		source.ast = Parser(m_errorReporter, m_evmVersion, m_parserErrorRecovery, m_astArena).parse(source.scanner);
 		if (!source.ast)
 			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
+			source.ast->annotation().path = _path;
+		parsedSources.insert(_path);
+	};
+	auto lastIDBefore = [&](vector<string> const& _parseOrder, size_t _index) -> size_t
+	{
+		return _index == 0 ? 0 : m_sources.at(_parseOrder[_index - 1]).ast->id();
+	};
+
+	// The IDs of the AST nodes depend on the order in which the sources are parsed: First the
+	// sources that were given directly, ordered by name, then the imported sources in the order
+	// in which they are found.
+	// After updateSources(), the sources in front of the first one that changed or moved keep
+	// their ASTs. All following sources are parsed again and get the IDs they get when parsing
+	// all sources from scratch.
+	vector<string> parseOrder;
+	for (auto const& [name, source]: m_sources)
+		if (!source.imported)
+			parseOrder.push_back(name);
+	set<string> listedSources(parseOrder.begin(), parseOrder.end());
+	bool keep = update;
+	for (size_t i = 0; i < parseOrder.size(); ++i)
+	{
+		string const path = parseOrder[i];
+		if (keep && (
+			i >= m_parseOrder.size() ||
+			m_parseOrder[i] != path ||
+			m_sourcesToUpdate.count(path) ||
+			!m_sources[path].ast
+		))
 		{
-			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
+			keep = false;
+			ASTNode::resetID(lastIDBefore(parseOrder, i));
+		}
+		if (!keep)
+			parseSource(path);
+
+		if (SourceUnit const* ast = m_sources[path].ast.get())
+			for (auto const& newSource: loadMissingSources(*ast, path, listedSources))
 			{
 				string const& newPath = newSource.first;
 				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
-				sourcesToParse.push_back(newPath);
+				if (!m_sources.count(newPath))
+					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+				m_sources[newPath].imported = true;
+				parseOrder.push_back(newPath);
+				listedSources.insert(newPath);
+			}
+	}
+
+	if (update)
+	{
+		// Sources that are not imported any more are dropped.
+		set<string> droppedSources;
+		for (auto it = m_sources.begin(); it != m_sources.end();)
+			if (listedSources.count(it->first))
+				++it;
+			else
+			{
+				if (it->second.ast)
+					m_replacedASTs.emplace_back(move(it->second.ast));
+				droppedSources.insert(it->first);
+				it = m_sources.erase(it);
+			}
+
+		// The kept sources that import a source which was parsed again have to be analyzed
+		// again as well. Since they did not change, parsing them again yields the same IDs.
+		for (bool importersFound = true; importersFound;)
+		{
+			importersFound = false;
+			for (size_t i = 0; i < parseOrder.size(); ++i)
+			{
+				SourceUnit const* ast = m_sources[parseOrder[i]].ast.get();
+				if (!ast || parsedSources.count(parseOrder[i]))
+					continue;
+				bool importsParsedSource = false;
+				for (ImportDirective const* import: ASTNode::filteredNodes<ImportDirective>(ast->nodes()))
+					if (parsedSources.count(import->annotation().absolutePath))
+						importsParsedSource = true;
+				if (!importsParsedSource)
+					continue;
+
+				size_t lastID = ast->id();
+				ASTNode::resetID(lastIDBefore(parseOrder, i));
+				parseSource(parseOrder[i]);
+				if (SourceUnit const* newAST = m_sources[parseOrder[i]].ast.get())
+				{
+					solAssert(newAST->id() == lastID, "Unchanged source got different IDs.");
+					StringMap newSources = loadMissingSources(*newAST, parseOrder[i], listedSources);
+					solAssert(newSources.empty(), "");
+				}
+				importersFound = true;
 			}
 		}
+		size_t lastID = 0;
+		for (auto const& source: m_sources)
+			if (source.second.ast)
+				lastID = max(lastID, source.second.ast->id());
+		ASTNode::resetID(lastID);
+
+		// Only the analysis is kept, all contracts are compiled again.
+		for (auto it = m_contracts.begin(); it != m_contracts.end();)
+		{
+			string const& sourceName = it->second.contract->sourceUnitName();
+			if (parsedSources.count(sourceName) || droppedSources.count(sourceName))
+				it = m_contracts.erase(it);
+			else
+			{
+				ContractDefinition const* contract = it->second.contract;
+				it->second = Contract{};
+				it->second.contract = contract;
+				++it;
+			}
+		}
+
+		// Keep the warnings of the unchanged sources and the general ones issued before parsing,
+		// the others are reported again.
+		set<Error const*> staleErrors;
+		for (size_t i = m_generalWarnings; i < previousErrors; ++i)
+		{
+			SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*m_errorList[i]);
+			if (
+				!location ||
+				!location->source ||
+				parsedSources.count(location->source->name()) ||
+				droppedSources.count(location->source->name())
+			)
+				staleErrors.insert(m_errorList[i].get());
+		}
+		m_errorReporter.removeErrors([&](Error const& _error) { return staleErrors.count(&_error); });
+		for (string const& name: parsedSources + droppedSources)
+			m_unhandledSMTLib2Queries.erase(name);
+
+		m_sourcesToUpdate = move(parsedSources);
 	}
+	m_parseOrder = move(parseOrder);
 
 	m_stackState = ParsingPerformed;
 	if (!Error::containsOnlyWarnings(m_errorReporter.errors()))
@@ -254,59 +441,94 @@ bool CompilerStack::analyze()
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was performed."));
 	resolveImports();
 
+	// After updateSources(), only the updated sources are analyzed, the others keep their annotations.
+	vector<Source const*> sourcesToAnalyze;
+	for (Source const* source: m_sourceOrder)
+		if (m_sourcesToUpdate.empty() || !source->ast || m_sourcesToUpdate.count(source->ast->annotation().path))
+			sourcesToAnalyze.push_back(source);
+	m_sourcesToUpdate.clear();
+
 	bool noErrors = true;
 
 	try
 	{
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (!syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		{
+			ScopedProfile profile("SyntaxChecker");
+			SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
+			for (Source const* source: sourcesToAnalyze)
+				if (!syntaxChecker.checkSyntax(*source->ast))
+					noErrors = false;
+		}
 
-		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (!docStringAnalyser.analyseDocStrings(*source->ast))
-				noErrors = false;
+		{
+			ScopedProfile profile("DocStringAnalyser");
+			DocStringAnalyser docStringAnalyser(m_errorReporter);
+			for (Source const* source: sourcesToAnalyze)
+				if (!docStringAnalyser.analyseDocStrings(*source->ast))
+					noErrors = false;
+		}
 
-		m_globalContext = make_shared<GlobalContext>();
-		NameAndTypeResolver resolver(*m_globalContext, m_scopes, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (!resolver.registerDeclarations(*source->ast))
-				return false;
-
-		map<string, SourceUnit const*> sourceUnitsByName;
-		for (auto& source: m_sources)
-			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
-			if (!resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
-
-		// This is the main name and type resolution loop. Needs to be run for every contract, because
-		// the special variables "this" and "super" must be set appropriately.
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-				{
+		{
+			ScopedProfile profile("NameAndTypeResolver");
+			if (!m_globalContext)
+				m_globalContext = make_shared<GlobalContext>();
+			else
+			{
+				// After updateSources(), the global declarations get the IDs they get when
+				// analyzing all sources from scratch, i.e. the ones following the last AST node.
+				size_t lastID = 0;
+				for (auto const& source: m_sources)
+					if (source.second.ast)
+						lastID = max(lastID, source.second.ast->id());
+				vector<ContractDefinition const*> contracts;
+				for (Source const* source: m_sourceOrder)
+					if (source->ast)
+						for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+							contracts.push_back(contract);
+				m_globalContext->resetIDs(lastID, contracts);
+			}
+			NameAndTypeResolver resolver(*m_globalContext, m_scopes, m_errorReporter);
+			for (Source const* source: sourcesToAnalyze)
+				if (!resolver.registerDeclarations(*source->ast))
+					return false;
+
+			map<string, SourceUnit const*> sourceUnitsByName;
+			for (auto& source: m_sources)
+				sourceUnitsByName[source.first] = source.second.ast.get();
+			for (Source const* source: sourcesToAnalyze)
+				if (!resolver.performImports(*source->ast, sourceUnitsByName))
+					return false;
+
+			// This is the main name and type resolution loop. Needs to be run for every contract, because
+			// the special variables "this" and "super" must be set appropriately.
+			for (Source const* source: sourcesToAnalyze)
+				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+					{
 
-					if (!resolver.resolveNamesAndTypes(*contract)) return false;
-					// Note that we now reference contracts by their fully qualified names, and
-					// thus contracts can only conflict if declared in the same source file.  This
-					// already causes a double-declaration error elsewhere, so we do not report
-					// an error here and instead silently drop any additional contracts we find.
-					if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
-						m_contracts[contract->fullyQualifiedName()].contract = contract;
-				}
+						if (!resolver.resolveNamesAndTypes(*contract)) return false;
+						// Note that we now reference contracts by their fully qualified names, and
+						// thus contracts can only conflict if declared in the same source file.  This
+						// already causes a double-declaration error elsewhere, so we do not report
+						// an error here and instead silently drop any additional contracts we find.
+						if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
+							m_contracts[contract->fullyQualifiedName()].contract = contract;
+					}
+		}
 
 		// Next, we check inheritance, overrides, function collisions and other things at
 		// contract or function level.
 		// This also calculates whether a contract is abstract, which is needed by the
 		// type checker.
-		ContractLevelChecker contractLevelChecker(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!contractLevelChecker.check(*contract))
-						noErrors = false;
+		{
+			ScopedProfile profile("ContractLevelChecker");
+			ContractLevelChecker contractLevelChecker(m_errorReporter);
+			for (Source const* source: sourcesToAnalyze)
+				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+						if (!contractLevelChecker.check(*contract))
+							noErrors = false;
+		}
 
 		// New we run full type checks that go down to the expression level. This
 		// cannot be done earlier, because we need cross-contract types and information
@@ -315,18 +537,22 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
-		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!typeChecker.checkTypeRequirements(*contract))
-						noErrors = false;
+		{
+			ScopedProfile profile("TypeChecker");
+			TypeChecker typeChecker(m_evmVersion, m_errorReporter);
+			for (Source const* source: sourcesToAnalyze)
+				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+						if (!typeChecker.checkTypeRequirements(*contract))
+							noErrors = false;
+		}
 
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
+			ScopedProfile profile("PostTypeChecker");
 			PostTypeChecker postTypeChecker(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyze)
 				if (!postTypeChecker.check(*source->ast))
 					noErrors = false;
 		}
@@ -335,15 +561,16 @@ bool CompilerStack::analyze()
 		{
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
+			ScopedProfile profile("ControlFlowAnalyzer");
 			CFG cfg(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyze)
 				if (!cfg.constructFlow(*source->ast))
 					noErrors = false;
 
 			if (noErrors)
 			{
 				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
-				for (Source const* source: m_sourceOrder)
+				for (Source const* source: sourcesToAnalyze)
 					if (!controlFlowAnalyzer.analyze(*source->ast))
 						noErrors = false;
 			}
@@ -352,8 +579,9 @@ bool CompilerStack::analyze()
 		if (noErrors)
 		{
 			// Checks for common mistakes. Only generates warnings.
+			ScopedProfile profile("StaticAnalyzer");
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyze)
 				if (!staticAnalyzer.analyze(*source->ast))
 					noErrors = false;
 		}
@@ -361,8 +589,9 @@ bool CompilerStack::analyze()
 		if (noErrors)
 		{
 			// Check for state mutability in every function.
+			ScopedProfile profile("ViewPureChecker");
 			vector<ASTPointer<ASTNode>> ast;
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyze)
 				ast.push_back(source->ast);
 
 			if (!ViewPureChecker(ast, m_errorReporter).check())
@@ -371,10 +600,10 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
+			ScopedProfile profile("ModelChecker");
 			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses);
-			for (Source const* source: m_sourceOrder)
-				modelChecker.analyze(*source->ast);
-			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
+			for (Source const* source: sourcesToAnalyze)
+				m_unhandledSMTLib2Queries[source->ast->annotation().path] = modelChecker.analyze(*source->ast);
 		}
 	}
 	catch (FatalError const&)
@@ -434,6 +663,11 @@ bool CompilerStack::compile()
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
 
 	// Only compile contracts individually which have been requested.
+	// Note that contracts are compiled one after the other, dependencies first.
+	// They cannot be compiled concurrently yet: code generation creates types lazily
+	// through the TypeProvider singleton, the assembly of a contract created via ``new``
+	// is shared with (and re-optimised in place by) the creating contract and parts of
+	// libevmasm and libyul still rely on unsynchronised static state.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
@@ -461,6 +695,14 @@ void CompilerStack::link()
 	}
 }
 
+vector<string> CompilerStack::unhandledSMTLib2Queries() const
+{
+	vector<string> queries;
+	for (auto const& sourceQueries: m_unhandledSMTLib2Queries)
+		queries += sourceQueries.second;
+	return queries;
+}
+
 vector<string> CompilerStack::contractNames() const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -826,7 +1068,11 @@ string const& CompilerStack::Source::ipfsUrl() const
 	return ipfsUrlCached;
 }
 
-StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
+StringMap CompilerStack::loadMissingSources(
+	SourceUnit const& _ast,
+	std::string const& _sourcePath,
+	set<string> const& _loadedSources
+)
 {
 	solAssert(m_stackState < ParsingPerformed, "");
 	StringMap newSources;
@@ -841,8 +1087,14 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 			// as seen globally.
 			importPath = applyRemapping(importPath, _sourcePath);
 			import->annotation().absolutePath = importPath;
-			if (m_sources.count(importPath) || newSources.count(importPath))
+			if (_loadedSources.count(importPath) || newSources.count(importPath))
+				continue;
+			// Sources imported before updateSources() are not read again.
+			if (m_sources.count(importPath))
+			{
+				newSources[importPath] = m_sources.at(importPath).scanner->source();
 				continue;
+			}
 
 			ReadCallback::Result result{false, string("File not supplied initially.")};
 			if (m_readFile)
@@ -975,6 +1227,7 @@ void CompilerStack::compileContract(
 	try
 	{
 		// Run optimiser and compile the contract.
+		ScopedProfile profile("ContractCompiler");
 		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
 	}
 	catch(eth::OptimizerException const&)
@@ -1021,6 +1274,7 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	for (auto const* dependency: _contract.annotation().contractDependencies)
 		generateIR(*dependency);
 
+	ScopedProfile profile("IRGenerator");
 	IRGenerator generator(m_evmVersion, m_optimiserSettings);
 	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract);
 }
@@ -1036,6 +1290,8 @@ void CompilerStack::generateEWasm(ContractDefinition const& _contract)
 	if (!compiledContract.eWasm.empty())
 		return;
 
+	ScopedProfile profile("EWasmGenerator");
+
 	// Re-parse the Yul IR in EVM dialect
 	yul::AssemblyStack evmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
 	evmStack.parseAndAnalyze("", compiledContract.yulIROptimized);
@@ -1153,11 +1409,15 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
 		details["cse"] = m_optimiserSettings.runCSE;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
+		if (m_optimiserSettings.runStackShuffle)
+			details["stackShuffle"] = true;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
 		if (m_optimiserSettings.runYulOptimiser)
 		{
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
+			if (m_optimiserSettings.yulOptimiserSteps != OptimiserSettings::DefaultYulOptimiserSteps)
+				details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
 		}
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
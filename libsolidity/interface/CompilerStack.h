@@ -65,6 +65,7 @@ namespace solidity
 {
 
 // forward declarations
+class ASTArena;
 class ASTNode;
 class ContractDefinition;
 class FunctionDefinition;
@@ -147,6 +148,16 @@ public:
 		m_parserErrorRecovery = _wantErrorRecovery;
 	}
 
+	/// Set whether the AST nodes are allocated from a single arena instead of
+	/// individually from the heap. This reduces allocation overhead and improves
+	/// locality for large compilations at the cost of releasing the memory only
+	/// once all nodes are gone.
+	/// Must be set before parsing.
+	void setASTArena(bool _useArena = false)
+	{
+		m_useASTArena = _useArena;
+	}
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -174,6 +185,14 @@ public:
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
 
+	/// Replaces the contents of the given sources or adds new sources after the sources were
+	/// analyzed. The next call to parseAndAnalyze() parses and analyzes the sources whose
+	/// contents changed, all sources that are parsed after them and the sources that
+	/// (transitively) import any of those. All other sources keep their ASTs and annotations.
+	/// The AST nodes get the same IDs as when compiling all sources from scratch.
+	/// Falls back to parsing and analyzing all sources again if the previous analysis failed.
+	void updateSources(StringMap _sources);
+
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
 	void addSMTLib2Response(h256 const& _hash, std::string const& _response);
@@ -215,7 +234,7 @@ public:
 
 	/// @returns a list of unhandled queries to the SMT solver (has to be supplied in a second run
 	/// by calling @a addSMTLib2Response).
-	std::vector<std::string> const& unhandledSMTLib2Queries() const { return m_unhandledSMTLib2Queries; }
+	std::vector<std::string> unhandledSMTLib2Queries() const;
 
 	/// @returns a list of the contract names in the sources.
 	std::vector<std::string> contractNames() const;
@@ -297,6 +316,8 @@ private:
 	{
 		std::shared_ptr<langutil::Scanner> scanner;
 		std::shared_ptr<SourceUnit> ast;
+		/// Whether the source was loaded through an import instead of being given directly.
+		bool imported = false;
 		h256 mutable keccak256HashCached;
 		h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
@@ -325,10 +346,15 @@ private:
 		mutable std::unique_ptr<std::string const> runtimeSourceMapping;
 	};
 
-	/// Loads the missing sources from @a _ast (named @a _path) using the callback
-	/// @a m_readFile and stores the absolute paths of all imports in the AST annotations.
+	/// Loads the sources imported by @a _ast (named @a _path) that are not among @a _loadedSources
+	/// using the callback @a m_readFile, unless they were already imported before updateSources(),
+	/// and stores the absolute paths of all imports in the AST annotations.
 	/// @returns the newly loaded sources.
-	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
+	StringMap loadMissingSources(
+		SourceUnit const& _ast,
+		std::string const& _path,
+		std::set<std::string> const& _loadedSources
+	);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
@@ -412,7 +438,16 @@ private:
 	/// "context:prefix=target"
 	std::vector<Remapping> m_remappings;
 	std::map<std::string const, Source> m_sources;
-	std::vector<std::string> m_unhandledSMTLib2Queries;
+	/// Sources that changed in a call to updateSources() and, after parsing, the sources to analyze.
+	/// If empty, all sources are parsed and analyzed.
+	std::set<std::string> m_sourcesToUpdate;
+	/// Names of the sources in the order in which they were parsed.
+	std::vector<std::string> m_parseOrder;
+	/// ASTs replaced by updateSources(). They are kept alive until the next reset,
+	/// since types and declaration containers can still refer to them.
+	std::vector<std::shared_ptr<SourceUnit>> m_replacedASTs;
+	/// Unhandled SMT queries by the name of the source they were encountered in.
+	std::map<std::string, std::vector<std::string>> m_unhandledSMTLib2Queries;
 	std::map<h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
@@ -421,8 +456,14 @@ private:
 	std::map<std::string const, Contract> m_contracts;
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
+	/// Number of warnings at the start of m_errorList that do not belong to any source.
+	/// They are kept by updateSources().
+	size_t m_generalWarnings = 0;
 	bool m_metadataLiteralSources = false;
 	bool m_parserErrorRecovery = false;
+	bool m_useASTArena = false;
+	/// Arena the AST nodes are allocated from if m_useASTArena is set.
+	std::shared_ptr<ASTArena> m_astArena;
 	State m_stackState = Empty;
 	/// Whether or not there has been an error during processing.
 	/// If this is true, the stack will refuse to generate code.
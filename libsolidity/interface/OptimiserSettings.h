@@ -23,6 +23,7 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
 
 namespace dev
 {
@@ -31,6 +32,31 @@ namespace solidity
 
 struct OptimiserSettings
 {
+	/// Default sequence of Yul optimiser steps, see yul::OptimiserSuite for the syntax.
+	static char constexpr DefaultYulOptimiserSteps[] =
+		// None of these can make stack problems worse.
+		"dhfoDgvufnTUtnIf"
+		"["
+			// Turn into SSA and simplify.
+			"xarrscL"
+			// Perform structural simplification.
+			"cCTUtTOntnfDIu"
+			// Simplify again.
+			"Lcu"
+			// Reverse SSA.
+			"Vcujj"
+			// Run functional expression inliner.
+			"eu"
+			// Turn into SSA again and simplify.
+			"xarrcL"
+			// Run full inliner.
+			"gvif"
+			// SSA plus simplify.
+			"CTUcarrLsTOtfDncarrIuc"
+		"]"
+		// Make source short and pretty.
+		"jmujujuVcTOcujmu";
+
 	/// No optimisations at all - not recommended.
 	static OptimiserSettings none()
 	{
@@ -78,8 +104,10 @@ struct OptimiserSettings
 			runDeduplicate == _other.runDeduplicate &&
 			runCSE == _other.runCSE &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
+			runStackShuffle == _other.runStackShuffle &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
+			yulOptimiserSteps == _other.yulOptimiserSteps &&
 			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
 	}
 
@@ -97,10 +125,15 @@ struct OptimiserSettings
 	/// Constant optimizer, which tries to find better representations that satisfy the given
 	/// size/cost-trade-off.
 	bool runConstantOptimiser = false;
+	/// Exhaustive search for shorter sequences of stack shuffling instructions (DUP, SWAP, POP).
+	/// Not part of the default settings.
+	bool runStackShuffle = false;
 	/// Perform more efficient stack allocation for variables during code generation from Yul to bytecode.
 	bool optimizeStackAllocation = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
 	bool runYulOptimiser = false;
+	/// Sequence of optimisation steps to be performed by the Yul optimiser.
+	std::string yulOptimiserSteps = DefaultYulOptimiserSteps;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
@@ -23,11 +23,14 @@
 #include <libsolidity/interface/StandardCompiler.h>
 
 #include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/interface/Version.h>
 #include <libyul/AssemblyStack.h>
+#include <libyul/optimiser/Suite.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 #include <libevmasm/Instruction.h>
 #include <libdevcore/JSON.h>
 #include <libdevcore/Keccak256.h>
+#include <libdevcore/Profiler.h>
 
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/algorithm/string.hpp>
@@ -281,6 +284,66 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns the contract-level artifacts requested for the contract @a _contract in @a _file.
+/// The components of the bytecode objects are combined into "evm.bytecode" and "evm.deployedBytecode".
+Json::Value requestedContractArtifacts(Json::Value const& _outputSelection, string const& _file, string const& _contract)
+{
+	static vector<string> const artifacts{
+		"abi", "metadata", "userdoc", "devdoc",
+		"ir", "irOptimized", "ewasm.wast", "ewasm.wasm",
+		"evm.assembly", "evm.legacyAssembly", "evm.methodIdentifiers", "evm.gasEstimates"
+	};
+	static vector<pair<string, vector<string>>> const objectArtifacts{
+		{"evm.bytecode", {
+			"evm.bytecode", "evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap",
+			"evm.bytecode.linkReferences"
+		}},
+		{"evm.deployedBytecode", {
+			"evm.deployedBytecode", "evm.deployedBytecode.object", "evm.deployedBytecode.opcodes",
+			"evm.deployedBytecode.sourceMap", "evm.deployedBytecode.linkReferences"
+		}}
+	};
+
+	Json::Value requested(Json::arrayValue);
+	for (string const& artifact: artifacts)
+		if (isArtifactRequested(_outputSelection, _file, _contract, artifact, false))
+			requested.append(artifact);
+	for (auto const& objectArtifact: objectArtifacts)
+		if (isArtifactRequested(_outputSelection, _file, _contract, objectArtifact.second, false))
+			requested.append(objectArtifact.first);
+	return requested;
+}
+
+/// @returns the key under which the output of @a _contractName is stored in the compilation cache.
+/// The metadata covers the compiler version, the settings and the contents of all sources the
+/// contract can depend on.
+h256 contractCacheKey(CompilerStack const& _compilerStack, string const& _contractName, Json::Value const& _artifacts)
+{
+	Json::Value key(Json::objectValue);
+	key["compiler"] = VersionString;
+	key["metadata"] = _compilerStack.metadata(_contractName);
+	key["artifacts"] = _artifacts;
+	// Source mappings and the legacy assembly refer to sources by their index.
+	key["sourceList"] = Json::arrayValue;
+	for (string const& sourceName: _compilerStack.sourceNames())
+		key["sourceList"].append(sourceName);
+	// The generated code depends on the AST IDs of the declarations the contract uses, e.g.
+	// through the names of the ABI coder routines or of the IR functions. Only the interface
+	// artifacts do not depend on them. Since the contents of the sources are fixed by the
+	// metadata, the ID of a source unit, which is its last node, fixes all IDs in the source.
+	static set<string> const interfaceArtifacts{"abi", "metadata", "userdoc", "devdoc", "evm.methodIdentifiers"};
+	for (Json::Value const& artifact: _artifacts)
+		if (!interfaceArtifacts.count(artifact.asString()))
+		{
+			SourceUnit const& sourceUnit = _compilerStack.ast(_contractName.substr(0, _contractName.rfind(':')));
+			key["sourceUnitIDs"][sourceUnit.annotation().path] = Json::UInt64(sourceUnit.id());
+			for (SourceUnit const* referencedSourceUnit: sourceUnit.referencedSourceUnits(true))
+				key["sourceUnitIDs"][referencedSourceUnit->annotation().path] = Json::UInt64(referencedSourceUnit->id());
+			break;
+		}
+	return keccak256(jsonCompactPrint(key));
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret(Json::objectValue);
@@ -350,7 +413,7 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings"};
+	static set<string> keys{"parserErrorRecovery", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "profile", "remappings"};
 	return checkKeys(_input, keys, "settings");
 }
 
@@ -362,7 +425,7 @@ std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails"};
+	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "stackShuffle", "yul", "yulDetails"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -471,6 +534,8 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "constantOptimizer", settings.runConstantOptimiser))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "stackShuffle", settings.runStackShuffle))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "yul", settings.runYulOptimiser))
 			return *error;
 		if (settings.runYulOptimiser)
@@ -480,10 +545,29 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
+			if (details["yulDetails"].isMember("optimizerSteps"))
+			{
+				Json::Value const& steps = details["yulDetails"]["optimizerSteps"];
+				if (!steps.isString())
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.optimizerSteps\" must be a string");
+				try
+				{
+					yul::OptimiserSuite::validateSequence(steps.asString());
+				}
+				catch (yul::OptimizerException const& _exception)
+				{
+					return formatFatalError(
+						"JSONError",
+						"Invalid optimizer step sequence in \"settings.optimizer.details.yulDetails.optimizerSteps\": " +
+						*boost::get_error_info<errinfo_comment>(_exception)
+					);
+				}
+				settings.yulOptimiserSteps = steps.asString();
+			}
 		}
 	}
 	return { std::move(settings) };
@@ -625,6 +709,13 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 	if (auto result = checkSettingsKeys(settings))
 		return *result;
 
+	{
+		Json::Value stackSettings = settings;
+		if (stackSettings.isObject())
+			stackSettings.removeMember("outputSelection");
+		ret.stackSettings = jsonCompactPrint(stackSettings) + jsonCompactPrint(auxInputs);
+	}
+
 	if (settings.isMember("parserErrorRecovery"))
 	{
 		if (!settings["parserErrorRecovery"].isBool())
@@ -632,6 +723,13 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 		ret.parserErrorRecovery = settings["parserErrorRecovery"].asBool();
 	}
 
+	if (settings.isMember("profile"))
+	{
+		if (!settings["profile"].isBool())
+			return formatFatalError("JSONError", "\"settings.profile\" must be a Boolean.");
+		ret.profile = settings["profile"].asBool();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -722,36 +820,144 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+CompilerStack& StandardCompiler::prepareCompilerStack(InputsAndSettings& _inputsAndSettings)
 {
-	CompilerStack compilerStack(m_readFile);
+	set<string> inputs;
+	for (auto const& source: _inputsAndSettings.sources)
+		inputs.insert(source.first);
+
+	bool reuse =
+		m_keepCompilerStack &&
+		m_compilerStack &&
+		m_compilerStackReusable &&
+		m_compilerStack->state() >= CompilerStack::State::ParsingPerformed &&
+		!m_compilerStack->hasError() &&
+		m_compilerStackSettings == _inputsAndSettings.stackSettings &&
+		includes(inputs.begin(), inputs.end(), m_compilerStackInputs.begin(), m_compilerStackInputs.end());
+
+	// Sources of the kept stack that were not inputs of the previous request were only
+	// reached through imports. They are read again and the stack is only kept if they did
+	// not change: Passing them as inputs would parse them at a different position than
+	// a new compiler stack does and thus change the AST IDs.
+	if (reuse)
+		for (string const& sourceName: m_compilerStack->sourceNames())
+			if (!_inputsAndSettings.sources.count(sourceName))
+			{
+				solAssert(!m_compilerStackInputs.count(sourceName), "");
+				ReadCallback::Result result = m_readFile ? m_readFile(sourceName) : ReadCallback::Result{false, {}};
+				if (!result.success || result.responseOrErrorMessage != m_compilerStack->scanner(sourceName).source())
+				{
+					reuse = false;
+					break;
+				}
+			}
 
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
-	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
-		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
-	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
-	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
-	compilerStack.setRemappings(_inputsAndSettings.remappings);
-	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
-	compilerStack.setLibraries(_inputsAndSettings.libraries);
-	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
-	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
+	if (reuse)
+		m_compilerStack->updateSources(_inputsAndSettings.sources);
+	else
+	{
+		// The YulStrings of the previous compiler stack are invalidated by the reset.
+		m_compilerStack.reset();
+		YulStringRepository::reset();
+
+		m_compilerStack = make_unique<CompilerStack>(m_readFile);
+		m_compilerStack->setSources(_inputsAndSettings.sources);
+		for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
+			m_compilerStack->addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
+		m_compilerStack->setEVMVersion(_inputsAndSettings.evmVersion);
+		m_compilerStack->setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
+		m_compilerStack->setRemappings(_inputsAndSettings.remappings);
+		m_compilerStack->setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
+		m_compilerStack->setLibraries(_inputsAndSettings.libraries);
+		m_compilerStack->useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
+		m_compilerStackSettings = _inputsAndSettings.stackSettings;
+	}
+	m_compilerStackInputs = std::move(inputs);
 
-	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	m_compilerStack->setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
+	m_compilerStack->enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	m_compilerStack->enableEWasmGeneration(isEWasmRequested(_inputsAndSettings.outputSelection));
 
-	compilerStack.enableEWasmGeneration(isEWasmRequested(_inputsAndSettings.outputSelection));
+	return *m_compilerStack;
+}
+
+Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+{
+	CompilerStack& compilerStack = prepareCompilerStack(_inputsAndSettings);
+	ScopeGuard releaseCompilerStack([&]() {
+		if (!m_keepCompilerStack)
+			m_compilerStack.reset();
+	});
+	StringMap const& sourceList = _inputsAndSettings.sources;
+	m_compilerStackReusable = false;
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
 	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
 
+	/// Outputs of contracts that were found in the cache and cache keys of the contracts
+	/// whose outputs are stored in the cache after compilation.
+	map<string, Json::Value> cachedOutputs;
+	map<string, h256> cacheKeys;
+	bool allOutputsCached = false;
+
 	try
 	{
-		if (binariesRequested)
+		// A kept compiler stack might already have analyzed all sources.
+		auto parseAndAnalyze = [&]() {
+			if (compilerStack.state() >= CompilerStack::State::AnalysisPerformed)
+				return !compilerStack.hasError();
+			return compilerStack.parseAndAnalyze();
+		};
+
+		if (binariesRequested && m_cache)
+		{
+			if (parseAndAnalyze())
+			{
+				map<string, set<string>> selectedContracts = requestedContractNames(_inputsAndSettings.outputSelection);
+				map<string, set<string>> contractsToCompile;
+				for (string const& contractName: compilerStack.contractNames())
+				{
+					size_t colon = contractName.rfind(':');
+					solAssert(colon != string::npos, "");
+					string file = contractName.substr(0, colon);
+					string name = contractName.substr(colon + 1);
+
+					Json::Value artifacts = requestedContractArtifacts(_inputsAndSettings.outputSelection, file, name);
+					if (artifacts.empty())
+					{
+						// Contracts without outputs are still compiled if they are selected,
+						// so that compilation fails in the same way as without the cache.
+						for (string const& selectedFile: {string(), file})
+							if (selectedContracts.count(selectedFile) && (
+								selectedContracts[selectedFile].count(string()) ||
+								selectedContracts[selectedFile].count(name)
+							))
+								contractsToCompile[file].insert(name);
+						continue;
+					}
+					h256 key = contractCacheKey(compilerStack, contractName, artifacts);
+					if (optional<Json::Value> output = m_cache->load(key))
+						cachedOutputs[contractName] = std::move(*output);
+					else
+					{
+						cacheKeys[contractName] = key;
+						contractsToCompile[file].insert(name);
+					}
+				}
+				if (contractsToCompile.empty())
+					allOutputsCached = true;
+				else
+				{
+					compilerStack.setRequestedContractNames(contractsToCompile);
+					compilerStack.compile();
+				}
+			}
+		}
+		else if (binariesRequested)
 			compilerStack.compile();
 		else
-			compilerStack.parseAndAnalyze();
+			parseAndAnalyze();
 
 		for (auto const& error: compilerStack.errors())
 		{
@@ -765,6 +971,8 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 				""
 			));
 		}
+
+		m_compilerStackReusable = true;
 	}
 	/// This is only thrown in a very few locations.
 	catch (Error const& _error)
@@ -846,7 +1054,9 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	}
 
 	bool analysisPerformed = compilerStack.state() >= CompilerStack::State::AnalysisPerformed;
-	bool const compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
+	bool const compilationSuccess =
+		compilerStack.state() == CompilerStack::State::CompilationSuccessful ||
+		(allOutputsCached && !compilerStack.hasError());
 
 	if (compilerStack.hasError() && !_inputsAndSettings.parserErrorRecovery)
 		analysisPerformed = false;
@@ -860,9 +1070,8 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	if (errors.size() > 0)
 		output["errors"] = std::move(errors);
 
-	if (!compilerStack.unhandledSMTLib2Queries().empty())
-		for (string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + keccak256(query).hex()] = query;
+	for (string const& query: compilerStack.unhandledSMTLib2Queries())
+		output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + keccak256(query).hex()] = query;
 
 	bool const wildcardMatchesExperimental = false;
 
@@ -887,6 +1096,15 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		string file = contractName.substr(0, colon);
 		string name = contractName.substr(colon + 1);
 
+		// Without the cache, no compiled outputs are emitted if the compilation of any
+		// contract failed.
+		if (compilationSuccess && cachedOutputs.count(contractName))
+		{
+			if (!cachedOutputs[contractName].empty())
+				contractsOutput[file][name] = std::move(cachedOutputs[contractName]);
+			continue;
+		}
+
 		// ABI, documentation and metadata
 		Json::Value contractData(Json::objectValue);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
@@ -948,6 +1166,9 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		if (!evmData.empty())
 			contractData["evm"] = evmData;
 
+		if (compilationSuccess && cacheKeys.count(contractName))
+			m_cache->store(cacheKeys[contractName], contractData);
+
 		if (!contractData.empty())
 		{
 			if (!contractsOutput.isMember(file))
@@ -973,6 +1194,10 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 	if (!_inputsAndSettings.libraries.empty())
 		return formatFatalError("JSONError", "Field \"settings.libraries\" cannot be used for Yul.");
 
+	// The YulStrings of a kept compiler stack are invalidated by the reset.
+	m_compilerStack.reset();
+	YulStringRepository::reset();
+
 	Json::Value output = Json::objectValue;
 
 	AssemblyStack stack(
@@ -1040,20 +1265,34 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
-
 	try
 	{
 		auto parsed = parseInput(_input);
 		if (parsed.type() == typeid(Json::Value))
 			return boost::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = boost::get<InputsAndSettings>(std::move(parsed));
+
+		bool const profile = settings.profile;
+		Profiler& profiler = Profiler::instance();
+		bool const profilerWasEnabled = profiler.enabled();
+		if (profile)
+		{
+			profiler.reset();
+			profiler.setEnabled(true);
+		}
+		ScopeGuard restoreProfiler([&]() { profiler.setEnabled(profilerWasEnabled); });
+
+		Json::Value output;
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			output = compileSolidity(std::move(settings));
 		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
+			output = compileYul(std::move(settings));
 		else
 			return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
+
+		if (profile)
+			output["profile"] = profiler.report();
+		return output;
 	}
 	catch (Json::LogicError const& _exception)
 	{
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 
 #include <optional>
@@ -55,12 +56,23 @@ public:
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
 
+	/// Enables a persistent cache for the outputs of individual contracts in @a _directory.
+	/// Contracts whose output is found in the cache are not compiled again.
+	void setCacheDirectory(boost::filesystem::path _directory) { m_cache.emplace(std::move(_directory)); }
+
+	/// Keeps the compiler stack alive between calls to compile(). If a request has the same
+	/// settings as the previous one and does not drop any of its sources, only the sources that
+	/// changed (and the sources importing them) are parsed and analyzed again, see
+	/// CompilerStack::updateSources. Sources loaded through the read callback are read again.
+	void keepCompilerStack(bool _keep = true) { m_keepCompilerStack = _keep; }
+
 private:
 	struct InputsAndSettings
 	{
 		std::string language;
 		Json::Value errors;
 		bool parserErrorRecovery = false;
+		bool profile = false;
 		std::map<std::string, std::string> sources;
 		std::map<h256, std::string> smtLib2Responses;
 		langutil::EVMVersion evmVersion;
@@ -69,16 +81,31 @@ private:
 		std::map<std::string, h160> libraries;
 		bool metadataLiteralSources = false;
 		Json::Value outputSelection;
+		/// All settings that have to be set before parsing, serialized.
+		std::string stackSettings;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	boost::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
+	/// @returns the compiler stack of the previous request with the sources updated if it can be
+	/// re-used, otherwise a new compiler stack for the given sources and settings.
+	CompilerStack& prepareCompilerStack(InputsAndSettings& _inputsAndSettings);
 	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	std::optional<CompilationCache> m_cache;
+	bool m_keepCompilerStack = false;
+	/// Compiler stack of the current or previous request.
+	std::unique_ptr<CompilerStack> m_compilerStack;
+	/// False if the previous request using m_compilerStack was aborted by an exception.
+	bool m_compilerStackReusable = false;
+	std::string m_compilerStackSettings;
+	/// Sources given directly in the previous request (as opposed to sources only reached
+	/// through imports). A request that drops any of them needs a new compiler stack.
+	std::set<std::string> m_compilerStackInputs;
 };
 
 }
@@ -63,6 +63,12 @@ public:
 		solAssert(m_location.source, "");
 		if (m_location.end < 0)
 			markEndPosition();
+		if (m_parser.m_arena)
+			return allocate_shared<NodeType>(
+				ASTArenaAllocator<NodeType>(m_parser.m_arena),
+				m_location,
+				std::forward<Args>(_args)...
+			);
 		return make_shared<NodeType>(m_location, std::forward<Args>(_args)...);
 	}
 
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTArena.h>
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
 
@@ -42,10 +43,12 @@ public:
 	explicit Parser(
 		langutil::ErrorReporter& _errorReporter,
 		langutil::EVMVersion _evmVersion,
-		bool _errorRecovery = false
+		bool _errorRecovery = false,
+		std::shared_ptr<ASTArena> _arena = nullptr
 	):
 		ParserBase(_errorReporter, _errorRecovery),
-		m_evmVersion(_evmVersion)
+		m_evmVersion(_evmVersion),
+		m_arena(std::move(_arena))
 	{}
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<langutil::Scanner> const& _scanner);
@@ -190,6 +193,8 @@ private:
 	/// Flag that signifies whether '_' is parsed as a PlaceholderStatement or a regular identifier.
 	bool m_insideModifier = false;
 	langutil::EVMVersion m_evmVersion;
+	/// Arena to allocate the AST nodes from, if set.
+	std::shared_ptr<ASTArena> m_arena;
 };
 
 }
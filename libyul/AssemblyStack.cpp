@@ -162,7 +162,10 @@ void AssemblyStack::optimize(Object& _object, bool _isCreation)
 		dialect,
 		meter.get(),
 		_object,
-		m_optimiserSettings.optimizeStackAllocation
+		m_optimiserSettings.optimizeStackAllocation,
+		{},
+		m_callSiteCounts ? &*m_callSiteCounts : nullptr,
+		m_optimiserSettings.yulOptimiserSteps
 	);
 }
 
@@ -26,12 +26,14 @@
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/CallSiteProfile.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
 #include <libevmasm/LinkerObject.h>
 
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace langutil
@@ -81,6 +83,10 @@ public:
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
 
+	/// Sets the execution counts of the function calls in the source (as produced by running
+	/// it in an interpreter), which are used to guide the optimizer.
+	void setCallSiteCounts(CallSiteCounts _counts) { m_callSiteCounts = std::move(_counts); }
+
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	MachineAssemblyObject assemble(Machine _machine) const;
 
@@ -104,6 +110,7 @@ private:
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	dev::solidity::OptimiserSettings m_optimiserSettings;
+	std::optional<CallSiteCounts> m_callSiteCounts;
 
 	std::shared_ptr<langutil::Scanner> m_scanner;
 
@@ -0,0 +1,106 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace yul;
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	uint64_t h = hash(_string);
+	Shard& shard = m_shards[h & (c_shardCount - 1)];
+	lock_guard<mutex> lock(shard.mutex);
+	auto range = shard.hashToID.equal_range(h);
+	for (auto it = range.first; it != range.second; ++it)
+		if (idToString(it->second) == _string)
+			return Handle{it->second, h};
+	size_t id = appendString(_string);
+	shard.hashToID.emplace_hint(range.second, make_pair(h, id));
+
+	return Handle{id, h};
+}
+
+void YulStringRepository::reset()
+{
+	{
+		lock_guard<mutex> lock(resetCallbacksMutex());
+		for (auto const& cb: resetCallbacks())
+			cb();
+	}
+	instance().clear();
+}
+
+YulStringRepository::ResetCallback::ResetCallback(function<void()> _fun)
+{
+	lock_guard<mutex> lock(resetCallbacksMutex());
+	YulStringRepository::resetCallbacks().emplace_back(move(_fun));
+}
+
+void YulStringRepository::clear()
+{
+	releaseChunks();
+	for (Shard& shard: m_shards)
+		shard.hashToID.clear();
+
+	size_t id = appendString(string{});
+	yulAssert(id == 0, "");
+	m_shards[emptyHash() & (c_shardCount - 1)].hashToID.emplace(emptyHash(), id);
+}
+
+void YulStringRepository::releaseChunks()
+{
+	for (auto& chunk: m_chunks)
+		delete[] chunk.exchange(nullptr, memory_order_relaxed);
+	m_size = 0;
+}
+
+size_t YulStringRepository::appendString(string const& _string)
+{
+	lock_guard<mutex> lock(m_storageMutex);
+	size_t id = m_size;
+	size_t chunkIndex = id >> c_chunkSizeBits;
+	yulAssert(chunkIndex < c_maxChunks, "Too many distinct YulStrings.");
+	string* chunk = m_chunks[chunkIndex].load(memory_order_relaxed);
+	if (!chunk)
+	{
+		chunk = new string[c_chunkSize];
+		m_chunks[chunkIndex].store(chunk, memory_order_release);
+	}
+	chunk[id & (c_chunkSize - 1)] = _string;
+	++m_size;
+	return id;
+}
+
+vector<function<void()>>& YulStringRepository::resetCallbacks()
+{
+	static vector<function<void()>> callbacks;
+	return callbacks;
+}
+
+mutex& YulStringRepository::resetCallbacksMutex()
+{
+	static mutex callbacksMutex;
+	return callbacksMutex;
+}
@@ -22,11 +22,15 @@
 
 #include <boost/noncopyable.hpp>
 
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
-#include <vector>
+#include <mutex>
 #include <string>
-#include <functional>
+#include <unordered_map>
+#include <vector>
 
 namespace yul
 {
@@ -35,7 +39,14 @@ namespace yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
-class YulStringRepository
+///
+/// Strings can be interned and looked up from multiple threads: The hash-to-ID index is split
+/// into shards that are locked independently and the strings themselves are stored in chunks
+/// that never move, so that looking up the string for an ID does not need a lock.
+/// The repository is still shared by the whole process and @a reset invalidates all YulStrings,
+/// so separate compilations cannot run concurrently if any of them resets it, which the
+/// Standard JSON interface does before each compilation.
+class YulStringRepository: boost::noncopyable
 {
 public:
 	struct Handle
@@ -50,22 +61,14 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	~YulStringRepository() { releaseChunks(); }
+
+	Handle stringToHandle(std::string const& _string);
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		std::string const* chunk = m_chunks[_id >> c_chunkSizeBits].load(std::memory_order_acquire);
+		return chunk[_id & (c_chunkSize - 1)];
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -80,41 +83,51 @@ public:
 		return hash;
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
-	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Clear the repository and release all string data.
+	/// Use with care - there cannot be any dangling YulString references
+	/// and the repository cannot be in use by another thread.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	static void reset();
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
-		ResetCallback(std::function<void()> _fun)
-		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
-		}
+		ResetCallback(std::function<void()> _fun);
 	};
 
 private:
-	YulStringRepository() = default;
-	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
-	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
-
-	static std::vector<std::function<void()>>& resetCallbacks()
+	/// Number of shards of the hash-to-ID index, must be a power of two.
+	static size_t constexpr c_shardCount = 16;
+	/// Strings are stored in chunks of 2**c_chunkSizeBits elements.
+	static size_t constexpr c_chunkSizeBits = 12;
+	static size_t constexpr c_chunkSize = size_t(1) << c_chunkSizeBits;
+	static size_t constexpr c_maxChunks = 4096;
+
+	struct Shard
 	{
-		static std::vector<std::function<void()>> callbacks;
-		return callbacks;
-	}
+		std::mutex mutex;
+		std::unordered_multimap<std::uint64_t, size_t> hashToID;
+	};
+
+	YulStringRepository() { clear(); }
+
+	/// Releases all strings and re-inserts the empty string as ID zero.
+	/// Not thread-safe.
+	void clear();
+	/// Frees the string storage without re-inserting anything. Not thread-safe.
+	void releaseChunks();
+	/// Stores a copy of @a _string and @returns its new ID.
+	size_t appendString(std::string const& _string);
+
+	static std::vector<std::function<void()>>& resetCallbacks();
+	static std::mutex& resetCallbacksMutex();
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::array<Shard, c_shardCount> m_shards;
+	/// Protects m_size and the allocation of new chunks.
+	std::mutex m_storageMutex;
+	size_t m_size = 0;
+	std::array<std::atomic<std::string*>, c_maxChunks> m_chunks{};
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -27,6 +27,9 @@
 
 #include <libdevcore/CommonData.h>
 
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/range/adaptor/reversed.hpp>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
@@ -123,9 +126,25 @@ Expression const* RepresentationFinder::tryFindRepresentation(dev::u256 const& _
 
 Representation const& RepresentationFinder::findRepresentation(dev::u256 const& _value)
 {
-	if (m_cache.count(_value))
+	// Previous results are only used if the search would have found them with the steps left,
+	// so that the result does not depend on which literals were optimised before.
+	if (m_cache.count(_value) && m_cache.at(_value).steps < m_maxSteps)
+	{
+		m_maxSteps -= m_cache.at(_value).steps;
 		return m_cache.at(_value);
+	}
+
+	dev::eth::ConstantRepresentationCache::Key key = cacheKey(_value);
+	if (auto entry = dev::eth::ConstantRepresentationCache::find(key))
+		if (entry->steps < m_maxSteps)
+		{
+			m_maxSteps -= entry->steps;
+			Representation routine = fromRoutine(entry->routine);
+			routine.steps = entry->steps;
+			return m_cache[_value] = move(routine);
+		}
 
+	size_t stepsBefore = m_maxSteps;
 	Representation routine = represent(_value);
 
 	if (dev::bytesRequired(~_value) < dev::bytesRequired(_value))
@@ -174,6 +193,11 @@ Representation const& RepresentationFinder::findRepresentation(dev::u256 const&
 		routine = min(move(routine), move(newRoutine));
 	}
 	yulAssert(MiniEVMInterpreter{m_dialect}.eval(*routine.expression) == _value, "Invalid expression generated.");
+	if (m_maxSteps > 0)
+	{
+		routine.steps = stepsBefore - m_maxSteps;
+		dev::eth::ConstantRepresentationCache::store(key, {toRoutine(*routine.expression), routine.steps});
+	}
 	return m_cache[_value] = move(routine);
 }
 
@@ -223,3 +247,57 @@ Representation RepresentationFinder::min(Representation _a, Representation _b)
 	else
 		return _b;
 }
+
+dev::eth::ConstantRepresentationCache::Key RepresentationFinder::cacheKey(dev::u256 const& _value) const
+{
+	return {
+		_value,
+		dev::eth::ConstantRepresentationCache::CostModel::Yul,
+		m_meter.isCreation(),
+		m_meter.runs(),
+		0,
+		m_dialect.evmVersion()
+	};
+}
+
+dev::eth::AssemblyItems RepresentationFinder::toRoutine(Expression const& _expression) const
+{
+	if (_expression.type() == typeid(Literal))
+		return {valueOfLiteral(boost::get<Literal>(_expression))};
+
+	FunctionCall const& call = boost::get<FunctionCall>(_expression);
+	BuiltinFunctionForEVM const* builtin = m_dialect.builtin(call.functionName.name);
+	yulAssert(builtin && builtin->instruction, "Expected EVM instruction.");
+	dev::eth::AssemblyItems routine;
+	// The first argument ends up on top of the stack.
+	for (auto const& argument: call.arguments | boost::adaptors::reversed)
+		routine += toRoutine(argument);
+	routine.emplace_back(*builtin->instruction);
+	return routine;
+}
+
+Representation RepresentationFinder::fromRoutine(dev::eth::AssemblyItems const& _routine) const
+{
+	vector<Representation> stack;
+	for (dev::eth::AssemblyItem const& item: _routine)
+		if (item.type() == dev::eth::Push)
+			stack.emplace_back(represent(item.data()));
+		else
+		{
+			yulAssert(item.type() == dev::eth::Operation, "");
+			YulString name{boost::to_lower_copy(dev::eth::instructionInfo(item.instruction()).name)};
+			yulAssert(stack.size() >= size_t(item.arguments()), "");
+			Representation result;
+			if (item.arguments() == 1)
+				result = represent(name, stack.back());
+			else
+			{
+				yulAssert(item.arguments() == 2, "");
+				result = represent(name, stack.back(), stack[stack.size() - 2]);
+			}
+			stack.resize(stack.size() - size_t(item.arguments()));
+			stack.emplace_back(move(result));
+		}
+	yulAssert(stack.size() == 1, "");
+	return move(stack.front());
+}
@@ -28,6 +28,9 @@
 
 #include <liblangutil/SourceLocation.h>
 
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/ConstantOptimiser.h>
+
 #include <libdevcore/Common.h>
 
 #include <tuple>
@@ -41,6 +44,8 @@ class GasMeter;
 
 /**
  * Optimisation stage that replaces constants by expressions that compute them.
+ * The representations found are shared with later runs through the
+ * dev::eth::ConstantRepresentationCache.
  *
  * Prerequisite: None
  */
@@ -58,6 +63,9 @@ public:
 	{
 		std::unique_ptr<Expression> expression;
 		size_t cost = size_t(-1);
+		/// Number of search steps needed to find the representation or size_t(-1) if the search
+		/// was cut short.
+		size_t steps = size_t(-1);
 	};
 
 private:
@@ -97,6 +105,13 @@ private:
 
 	Representation min(Representation _a, Representation _b);
 
+	/// @returns the key of @a _value in the dev::eth::ConstantRepresentationCache.
+	dev::eth::ConstantRepresentationCache::Key cacheKey(dev::u256 const& _value) const;
+	/// Converts the representation into a routine of pushes and operations for the cache.
+	dev::eth::AssemblyItems toRoutine(Expression const& _expression) const;
+	/// Rebuilds the representation from a routine stored in the cache.
+	Representation fromRoutine(dev::eth::AssemblyItems const& _routine) const;
+
 	EVMDialect const& m_dialect;
 	GasMeter const& m_meter;
 	langutil::SourceLocation m_location;
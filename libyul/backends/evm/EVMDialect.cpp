@@ -34,12 +34,17 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <mutex>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
 
 namespace
 {
+/// Protects the caches of dialect instances, which are shared between compilations.
+mutex dialectsMutex;
+
 pair<YulString, BuiltinFunctionForEVM> createEVMFunction(
 	string const& _name,
 	dev::eth::Instruction _instruction
@@ -189,6 +194,7 @@ EVMDialect const& EVMDialect::looseAssemblyForEVM(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Loose, false, _version);
 	return *dialects[_version];
@@ -198,6 +204,7 @@ EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Strict, false, _version);
 	return *dialects[_version];
@@ -207,6 +214,7 @@ EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Strict, true, _version);
 	return *dialects[_version];
@@ -216,6 +224,7 @@ EVMDialect const& EVMDialect::yulForEVM(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Yul, false, _version);
 	return *dialects[_version];
@@ -51,6 +51,9 @@ public:
 	/// the costs for its arguments.
 	size_t instructionCosts(dev::eth::Instruction _instruction) const;
 
+	bool isCreation() const { return m_isCreation; }
+	size_t runs() const { return m_runs; }
+
 private:
 	size_t combineCosts(std::pair<size_t, size_t> _costs) const;
 
@@ -697,7 +697,7 @@ Object EVMToEWasmTranslator::run(Object const& _object)
 	Block ast = boost::get<Block>(Disambiguator(m_dialect, *_object.analysisInfo)(*_object.code));
 	set<YulString> reservedIdentifiers;
 	NameDispenser nameDispenser{m_dialect, ast, reservedIdentifiers};
-	OptimiserStepContext context{m_dialect, nameDispenser, reservedIdentifiers};
+	OptimiserStepContext context{m_dialect, nameDispenser, reservedIdentifiers, nullptr};
 
 	FunctionHoister::run(context, ast);
 	FunctionGrouper::run(context, ast);
@@ -0,0 +1,103 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Execution counts of function calls, used to guide the optimiser.
+ */
+
+#include <libyul/optimiser/CallSiteProfile.h>
+
+#include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+Json::Value yul::callSiteProfileToJson(CallSiteProfile const& _profile)
+{
+	Json::Value sources(Json::objectValue);
+	for (auto const& [sourceName, hash]: _profile.sourceHashes)
+	{
+		sources[sourceName]["keccak256"] = "0x" + hash.hex();
+		sources[sourceName]["callSites"] = Json::arrayValue;
+	}
+	for (auto const& [location, count]: _profile.counts)
+	{
+		auto const& [sourceName, start, end] = location;
+		Json::Value callSite(Json::objectValue);
+		callSite["start"] = start;
+		callSite["end"] = end;
+		callSite["count"] = Json::UInt64(count);
+		sources[sourceName]["callSites"].append(move(callSite));
+	}
+	Json::Value profile(Json::objectValue);
+	profile["sources"] = move(sources);
+	return profile;
+}
+
+optional<CallSiteProfile> yul::callSiteProfileFromJson(string const& _json)
+{
+	Json::Value profile;
+	if (!jsonParseStrict(_json, profile) || !profile.isObject() || !profile["sources"].isObject())
+		return nullopt;
+
+	CallSiteProfile result;
+	for (string const& sourceName: profile["sources"].getMemberNames())
+	{
+		Json::Value const& source = profile["sources"][sourceName];
+		if (
+			!source.isObject() ||
+			!source["keccak256"].isString() ||
+			source["keccak256"].asString().size() != size_t(2 + 2 * h256::size) ||
+			!isValidHex(source["keccak256"].asString()) ||
+			!source["callSites"].isArray()
+		)
+			return nullopt;
+		result.sourceHashes[sourceName] = h256(source["keccak256"].asString());
+
+		for (auto const& callSite: source["callSites"])
+		{
+			if (
+				!callSite.isObject() ||
+				!callSite["start"].isInt() ||
+				!callSite["end"].isInt() ||
+				!callSite["count"].isUInt64()
+			)
+				return nullopt;
+			result.counts[{sourceName, callSite["start"].asInt(), callSite["end"].asInt()}] +=
+				size_t(callSite["count"].asUInt64());
+		}
+	}
+	return result;
+}
+
+optional<CallSiteCounts> yul::callSiteCountsForSource(
+	CallSiteProfile const& _profile,
+	string const& _sourceName,
+	string const& _source
+)
+{
+	auto hash = _profile.sourceHashes.find(_sourceName);
+	if (hash == _profile.sourceHashes.end() || hash->second != keccak256(_source))
+		return nullopt;
+
+	CallSiteCounts counts;
+	for (auto const& [location, count]: _profile.counts)
+		if (get<0>(location) == _sourceName)
+			counts[location] = count;
+	return counts;
+}
@@ -0,0 +1,63 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Execution counts of function calls, used to guide the optimiser.
+ */
+
+#pragma once
+
+#include <libdevcore/FixedHash.h>
+
+#include <json/json.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+
+namespace yul
+{
+
+/// Number of times each function call was executed, by the name of the source and the start
+/// and end offset of the source location of the call.
+using CallSiteCounts = std::map<std::tuple<std::string, int, int>, size_t>;
+
+/// Execution counts of function calls together with the Keccak-256 hashes of the contents
+/// of the sources they were recorded for, by source name.
+struct CallSiteProfile
+{
+	std::map<std::string, dev::h256> sourceHashes;
+	CallSiteCounts counts;
+};
+
+/// @returns the profile in the form
+/// {"sources": {<name>: {"keccak256": <hash>, "callSites": [{"start": <offset>, "end": <offset>, "count": <executions>}, ...]}}}
+Json::Value callSiteProfileToJson(CallSiteProfile const& _profile);
+
+/// Parses a profile written by callSiteProfileToJson.
+/// @returns nullopt if the input is not a valid profile.
+std::optional<CallSiteProfile> callSiteProfileFromJson(std::string const& _json);
+
+/// @returns the execution counts of the calls in the source named @a _sourceName or nullopt
+/// if @a _profile was not recorded for this source with exactly the content @a _source.
+std::optional<CallSiteCounts> callSiteCountsForSource(
+	CallSiteProfile const& _profile,
+	std::string const& _sourceName,
+	std::string const& _source
+);
+
+}
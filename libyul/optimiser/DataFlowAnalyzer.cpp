@@ -44,26 +44,32 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 	{
 		ASTModifier::operator()(_statement);
 		set<YulString> keysToErase;
-		for (auto const& item: m_storage.values)
+		for (auto const& item: m_storage->values)
 			if (!(
 				m_knowledgeBase.knownToBeDifferent(vars->first, item.first) ||
 				m_knowledgeBase.knownToBeEqual(vars->second, item.second)
 			))
 				keysToErase.insert(item.first);
-		for (YulString const& key: keysToErase)
-			m_storage.eraseKey(key);
-		m_storage.set(vars->first, vars->second);
+		auto it = m_storage->values.find(vars->first);
+		if (!keysToErase.empty() || it == m_storage->values.end() || it->second != vars->second)
+		{
+			InvertibleMap<YulString, YulString>& storage = m_storage.write();
+			for (YulString const& key: keysToErase)
+				storage.eraseKey(key);
+			storage.set(vars->first, vars->second);
+		}
 	}
 	else if (auto vars = isSimpleStore(dev::eth::Instruction::MSTORE, _statement))
 	{
 		ASTModifier::operator()(_statement);
 		set<YulString> keysToErase;
-		for (auto const& item: m_memory.values)
+		for (auto const& item: m_memory->values)
 			if (!m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, item.first))
 				keysToErase.insert(item.first);
+		InvertibleMap<YulString, YulString>& memory = m_memory.write();
 		for (YulString const& key: keysToErase)
-			m_memory.eraseKey(key);
-		m_memory.set(vars->first, vars->second);
+			memory.eraseKey(key);
+		memory.set(vars->first, vars->second);
 	}
 	else
 	{
@@ -102,8 +108,8 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	InvertibleMap<YulString, YulString> storage = m_storage;
-	InvertibleMap<YulString, YulString> memory = m_memory;
+	KnowledgeMap storage = m_storage;
+	KnowledgeMap memory = m_memory;
 
 	ASTModifier::operator()(_if);
 
@@ -121,8 +127,8 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	set<YulString> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		InvertibleMap<YulString, YulString> storage = m_storage;
-		InvertibleMap<YulString, YulString> memory = m_memory;
+		KnowledgeMap storage = m_storage;
+		KnowledgeMap memory = m_memory;
 		(*this)(_case.body);
 		joinKnowledge(storage, memory);
 
@@ -144,8 +150,8 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	// but this could be difficult if it is subclassed.
 	map<YulString, Expression const*> value;
 	InvertibleRelation<YulString> references;
-	InvertibleMap<YulString, YulString> storage;
-	InvertibleMap<YulString, YulString> memory;
+	KnowledgeMap storage;
+	KnowledgeMap memory;
 	m_value.swap(value);
 	swap(m_references, references);
 	swap(m_storage, storage);
@@ -231,14 +237,9 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 	for (auto const& name: _variables)
 	{
 		m_references.set(name, referencedVariables);
-		// assignment to slot denoted by "name"
-		m_storage.eraseKey(name);
-		// assignment to slot contents denoted by "name"
-		m_storage.eraseValue(name);
-		// assignment to slot denoted by "name"
-		m_memory.eraseKey(name);
-		// assignment to slot contents denoted by "name"
-		m_memory.eraseValue(name);
+		// assignment to slot or slot contents denoted by "name"
+		eraseKeyAndValue(m_storage, name);
+		eraseKeyAndValue(m_memory, name);
 	}
 }
 
@@ -273,14 +274,9 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 	// since the value is still unchanged.
 	for (auto const& name: _variables)
 	{
-		// clear slot denoted by "name"
-		m_storage.eraseKey(name);
-		// clear slot contents denoted by "name"
-		m_storage.eraseValue(name);
-		// assignment to slot denoted by "name"
-		m_memory.eraseKey(name);
-		// assignment to slot contents denoted by "name"
-		m_memory.eraseValue(name);
+		// clear slot or slot contents denoted by "name"
+		eraseKeyAndValue(m_storage, name);
+		eraseKeyAndValue(m_memory, name);
 	}
 
 	// Also clear variables that reference variables to be cleared.
@@ -299,47 +295,64 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 {
 	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects);
 	if (sideEffects.invalidatesStorage())
-		m_storage.clear();
+		clear(m_storage);
 	if (sideEffects.invalidatesMemory())
-		m_memory.clear();
+		clear(m_memory);
 }
 
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 {
 	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
 	if (sideEffects.invalidatesStorage())
-		m_storage.clear();
+		clear(m_storage);
 	if (sideEffects.invalidatesMemory())
-		m_memory.clear();
+		clear(m_memory);
 }
 
-void DataFlowAnalyzer::joinKnowledge(
-	InvertibleMap<YulString, YulString> const& _olderStorage,
-	InvertibleMap<YulString, YulString> const& _olderMemory
-)
+void DataFlowAnalyzer::joinKnowledge(KnowledgeMap const& _olderStorage, KnowledgeMap const& _olderMemory)
 {
 	joinKnowledgeHelper(m_storage, _olderStorage);
 	joinKnowledgeHelper(m_memory, _olderMemory);
 }
 
-void DataFlowAnalyzer::joinKnowledgeHelper(
-	InvertibleMap<YulString, YulString>& _this,
-	InvertibleMap<YulString, YulString> const& _older
-)
+void DataFlowAnalyzer::joinKnowledgeHelper(KnowledgeMap& _this, KnowledgeMap const& _older)
 {
+	// Nothing has changed since the older point.
+	if (_this.sharesValueWith(_older))
+		return;
+
 	// We clear if the key does not exist in the older map or if the value is different.
 	// This also works for memory because _older is an "older version"
 	// of m_memory and thus any overlapping write would have cleared the keys
 	// that are not known to be different inside m_memory already.
 	set<YulString> keysToErase;
-	for (auto const& item: _this.values)
+	for (auto const& item: _this->values)
 	{
-		auto it = _older.values.find(item.first);
-		if (it == _older.values.end() || it->second != item.second)
+		auto it = _older->values.find(item.first);
+		if (it == _older->values.end() || it->second != item.second)
 			keysToErase.insert(item.first);
 	}
+	if (keysToErase.empty())
+		return;
+	InvertibleMap<YulString, YulString>& data = _this.write();
 	for (auto const& key: keysToErase)
-		_this.eraseKey(key);
+		data.eraseKey(key);
+}
+
+void DataFlowAnalyzer::eraseKeyAndValue(KnowledgeMap& _data, YulString _name)
+{
+	auto references = _data->references.find(_name);
+	if (!_data->values.count(_name) && (references == _data->references.end() || references->second.empty()))
+		return;
+	InvertibleMap<YulString, YulString>& data = _data.write();
+	data.eraseKey(_name);
+	data.eraseValue(_name);
+}
+
+void DataFlowAnalyzer::clear(KnowledgeMap& _data)
+{
+	if (!_data->values.empty() || !_data->references.empty())
+		_data = KnowledgeMap();
 }
 
 bool DataFlowAnalyzer::inScope(YulString _variableName) const
@@ -31,6 +31,7 @@
 // TODO avoid
 #include <libevmasm/Instruction.h>
 
+#include <libdevcore/CopyOnWrite.h>
 #include <libdevcore/InvertibleMap.h>
 
 #include <map>
@@ -63,12 +64,16 @@ struct SideEffects;
  * This works also for memory (where addresses overlap) because one branch is always an
  * older version of the other and thus overlapping contents would have been deleted already
  * at the point of assignment.
+ * The storage and memory knowledge is shared between the snapshots taken at branches and the
+ * current state until it is modified, so that branches which do not change it are cheap.
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
 class DataFlowAnalyzer: public ASTModifier
 {
 public:
+	using KnowledgeMap = dev::CopyOnWrite<InvertibleMap<YulString, YulString>>;
+
 	/// @param _functionSideEffects
 	///            Side-effects of user-defined functions. Worst-case side-effects are assumed
 	///            if this is not provided or the function is not found.
@@ -115,15 +120,15 @@ protected:
 	/// Joins knowledge about storage and memory with an older point in the control-flow.
 	/// This only works if the current state is a direct successor of the older point,
 	/// i.e. `_otherStorage` and `_otherMemory` cannot have additional changes.
-	void joinKnowledge(
-		InvertibleMap<YulString, YulString> const& _olderStorage,
-		InvertibleMap<YulString, YulString> const& _olderMemory
-	);
+	void joinKnowledge(KnowledgeMap const& _olderStorage, KnowledgeMap const& _olderMemory);
+
+	static void joinKnowledgeHelper(KnowledgeMap& _thisData, KnowledgeMap const& _olderData);
 
-	static void joinKnowledgeHelper(
-		InvertibleMap<YulString, YulString>& _thisData,
-		InvertibleMap<YulString, YulString> const& _olderData
-	);
+	/// Removes the entry with key @a _name and all entries with value @a _name from @a _data.
+	/// Does not modify (and thus does not unshare) @a _data if there are no such entries.
+	static void eraseKeyAndValue(KnowledgeMap& _data, YulString _name);
+	/// Removes all entries from @a _data without unsharing it.
+	static void clear(KnowledgeMap& _data);
 
 	/// Returns true iff the variable is in scope.
 	bool inScope(YulString _variableName) const;
@@ -144,8 +149,8 @@ protected:
 	/// m_references.backward[b].contains(a) <=> the current expression assigned to a references b
 	InvertibleRelation<YulString> m_references;
 
-	InvertibleMap<YulString, YulString> m_storage;
-	InvertibleMap<YulString, YulString> m_memory;
+	KnowledgeMap m_storage;
+	KnowledgeMap m_memory;
 
 	KnowledgeBase m_knowledgeBase;
 
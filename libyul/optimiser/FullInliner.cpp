@@ -40,12 +40,20 @@ using namespace yul;
 
 void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	FullInliner{_ast, _context.dispenser}.run();
+	FullInliner{_ast, _context.dispenser, _context.callSiteCounts}.run();
 }
 
-FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser):
-	m_ast(_ast), m_nameDispenser(_dispenser)
+FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, CallSiteCounts const* _callSiteCounts):
+	m_ast(_ast), m_nameDispenser(_dispenser), m_callSiteCounts(_callSiteCounts)
 {
+	if (m_callSiteCounts && !m_callSiteCounts->empty())
+	{
+		size_t totalCount = 0;
+		for (auto const& callSite: *m_callSiteCounts)
+			totalCount += callSite.second;
+		m_hotCallThreshold = max<size_t>(1, totalCount / m_callSiteCounts->size());
+	}
+
 	// Determine constants
 	SSAValueTracker tracker;
 	tracker(m_ast);
@@ -81,6 +89,7 @@ void FullInliner::run()
 	{
 		handleBlock(fun.second->name, fun.second->body);
 		updateCodeSize(*fun.second);
+		m_recursive.erase(fun.first);
 	}
 }
 
@@ -102,13 +111,20 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 	if (size <= 1)
 		return true;
 
+	optional<size_t> executions = executionCount(_funCall);
+	bool hot = executions && *executions >= m_hotCallThreshold;
+
 	// Do not inline into already big functions.
-	if (m_functionSizes.at(_callSite) > 45)
+	if (m_functionSizes.at(_callSite) > (hot ? 90 : 45))
 		return false;
 
 	if (m_singleUse.count(calledFunction->name))
 		return true;
 
+	// Keep the code small where it is not executed.
+	if (executions && *executions == 0)
+		return false;
+
 	// Constant arguments might provide a means for further optimization, so they cause a bonus.
 	bool constantArg = false;
 	for (auto const& argument: _funCall.arguments)
@@ -121,9 +137,25 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 			break;
 		}
 
+	if (hot)
+		return (size < 15 || (constantArg && size < 30));
 	return (size < 6 || (constantArg && size < 12));
 }
 
+optional<size_t> FullInliner::executionCount(FunctionCall const& _funCall) const
+{
+	if (!m_callSiteCounts || !_funCall.location.source || _funCall.location.start < 0)
+		return nullopt;
+	auto it = m_callSiteCounts->find({
+		_funCall.location.source->name(),
+		_funCall.location.start,
+		_funCall.location.end
+	});
+	if (it == m_callSiteCounts->end())
+		return 0;
+	return it->second;
+}
+
 void FullInliner::tentativelyUpdateCodeSize(YulString _function, YulString _callSite)
 {
 	m_functionSizes.at(_callSite) += m_functionSizes.at(_function);
@@ -141,8 +173,13 @@ void FullInliner::handleBlock(YulString _currentFunctionName, Block& _block)
 
 bool FullInliner::recursive(FunctionDefinition const& _fun) const
 {
-	map<YulString, size_t> references = ReferencesCounter::countReferences(_fun);
-	return references[_fun.name] > 0;
+	auto it = m_recursive.find(_fun.name);
+	if (it == m_recursive.end())
+	{
+		map<YulString, size_t> references = ReferencesCounter::countReferences(_fun);
+		it = m_recursive.emplace(_fun.name, references[_fun.name] > 0).first;
+	}
+	return it->second;
 }
 
 void InlineModifier::operator()(Block& _block)
@@ -181,6 +218,11 @@ vector<Statement> InlineModifier::performInline(Statement& _statement, FunctionC
 
 	FunctionDefinition* function = m_driver.function(_funCall.functionName.name);
 	assertThrow(!!function, OptimizerException, "Attempt to inline invalid function.");
+	newStatements.reserve(
+		function->parameters.size() +
+		2 * function->returnVariables.size() +
+		function->body.statements.size()
+	);
 
 	m_driver.tentativelyUpdateCodeSize(function->name, m_currentFunction);
 
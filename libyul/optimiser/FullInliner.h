@@ -64,6 +64,10 @@ class NameCollector;
  * code of f, with replacements: a -> f_a, b -> f_b, c -> f_c
  * let z := f_c
  *
+ * If execution counts of the function calls are provided (see CallSiteProfile.h), calls that
+ * were executed at least as often as the average executed call are inlined more aggressively
+ * and calls that were never executed are only inlined if that does not increase the code size.
+ *
  * Prerequisites: Disambiguator
  * More efficient if run after: Function Hoister, Expression Splitter
  */
@@ -91,11 +95,17 @@ public:
 	void tentativelyUpdateCodeSize(YulString _function, YulString _callSite);
 
 private:
-	FullInliner(Block& _ast, NameDispenser& _dispenser);
+	FullInliner(Block& _ast, NameDispenser& _dispenser, CallSiteCounts const* _callSiteCounts);
 	void run();
 
+	/// @returns the number of times the call was executed according to the profile or
+	/// nullopt if there is no profile or the call has no source location.
+	std::optional<size_t> executionCount(FunctionCall const& _funCall) const;
+
 	void updateCodeSize(FunctionDefinition const& _fun);
 	void handleBlock(YulString _currentFunctionName, Block& _block);
+	/// @returns true if the function calls itself. The result is cached until the body
+	/// of the function is modified by inlining.
 	bool recursive(FunctionDefinition const& _fun) const;
 
 	/// The AST to be modified. The root block itself will not be modified, because
@@ -107,7 +117,12 @@ private:
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulString> m_constants;
 	std::map<YulString, size_t> m_functionSizes;
+	/// Functions known to be recursive or not, invalidated when inlining into the function.
+	mutable std::map<YulString, bool> m_recursive;
 	NameDispenser& m_nameDispenser;
+	CallSiteCounts const* m_callSiteCounts = nullptr;
+	/// Calls executed at least this often are considered hot.
+	size_t m_hotCallThreshold = 1;
 };
 
 /**
@@ -74,13 +74,13 @@ void LoadResolver::tryResolve(
 	YulString key = boost::get<Identifier>(_arguments.at(0)).name;
 	if (
 		_instruction == dev::eth::Instruction::SLOAD &&
-		m_storage.values.count(key)
+		m_storage->values.count(key)
 	)
-		_e = Identifier{locationOf(_e), m_storage.values[key]};
+		_e = Identifier{locationOf(_e), m_storage->values.at(key)};
 	else if (
 		m_optimizeMLoad &&
 		_instruction == dev::eth::Instruction::MLOAD &&
-		m_memory.values.count(key)
+		m_memory->values.count(key)
 	)
-		_e = Identifier{locationOf(_e), m_memory.values[key]};
+		_e = Identifier{locationOf(_e), m_memory->values.at(key)};
 }
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <libyul/Exceptions.h>
+#include <libyul/optimiser/CallSiteProfile.h>
 
 #include <string>
 #include <set>
@@ -35,6 +36,8 @@ struct OptimiserStepContext
 	Dialect const& dialect;
 	NameDispenser& dispenser;
 	std::set<YulString> const& reservedIdentifiers;
+	/// Execution counts of the function calls in the code, if a profile is available.
+	CallSiteCounts const* callSiteCounts;
 };
 
 
@@ -49,19 +49,21 @@ SimplificationRule<yul::Pattern> const* SimplificationRules::findFirstMatch(
 	static SimplificationRules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	vector<Expression> const& arguments = *instruction->second;
+	auto argumentShape = [&](size_t _i) { return Pattern::shape(arguments[_i], _dialect, _ssaValues); };
+	for (auto const* rule: rules.m_rules.candidates(instruction->first, arguments.size(), argumentShape))
 	{
 		rules.resetMatchGroups();
-		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
+		if (rule->pattern.matches(_expr, _dialect, _ssaValues))
+			if (!rule->feasible || rule->feasible())
+				return rule;
 	}
 	return nullptr;
 }
 
 bool SimplificationRules::isInitialized() const
 {
-	return !m_rules[uint8_t(dev::eth::Instruction::ADD)].empty();
+	return !m_rules.empty(dev::eth::Instruction::ADD);
 }
 
 std::optional<std::pair<dev::eth::Instruction, vector<Expression> const*>>
@@ -86,7 +88,7 @@ void SimplificationRules::addRules(vector<SimplificationRule<Pattern>> const& _r
 
 void SimplificationRules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	m_rules.add(_rule);
 }
 
 SimplificationRules::SimplificationRules()
@@ -110,6 +112,7 @@ SimplificationRules::SimplificationRules()
 	Z.setMatchGroup(7, m_matchGroups);
 
 	addRules(simplificationRuleList(A, B, C, W, X, Y, Z));
+	m_rules.build();
 	assertThrow(isInitialized(), OptimizerException, "Rule list not properly initialized.");
 }
 
@@ -120,7 +123,7 @@ yul::Pattern::Pattern(dev::eth::Instruction _instruction, vector<Pattern> const&
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, MatchGroups<Expression>& _matchGroups)
 {
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
@@ -211,6 +214,41 @@ dev::eth::Instruction Pattern::instruction() const
 	return m_instruction;
 }
 
+optional<unsigned> Pattern::shape() const
+{
+	if (m_kind == PatternKind::Operation)
+		return unsigned(m_instruction);
+	else if (m_kind == PatternKind::Constant)
+		return SimplificationRuleIndex<Pattern>::constantShape;
+	return nullopt;
+}
+
+unsigned Pattern::shape(
+	Expression const& _expr,
+	Dialect const& _dialect,
+	map<YulString, Expression const*> const& _ssaValues
+)
+{
+	// Resolve the variable like in matches().
+	Expression const* expr = &_expr;
+	if (_expr.type() == typeid(Identifier))
+	{
+		YulString varName = boost::get<Identifier>(_expr).name;
+		if (_ssaValues.count(varName))
+			if (Expression const* value = _ssaValues.at(varName))
+				expr = value;
+	}
+
+	if (expr->type() == typeid(Literal))
+	{
+		if (boost::get<Literal>(*expr).kind == LiteralKind::Number)
+			return SimplificationRuleIndex<Pattern>::constantShape;
+	}
+	else if (auto instruction = SimplificationRules::instructionAndArguments(_dialect, *expr))
+		return unsigned(instruction->first);
+	return SimplificationRuleIndex<Pattern>::otherShape;
+}
+
 Expression Pattern::toExpression(SourceLocation const& _location) const
 {
 	if (matchGroup())
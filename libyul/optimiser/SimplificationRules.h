@@ -66,8 +66,8 @@ private:
 
 	void resetMatchGroups() { m_matchGroups.clear(); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<dev::eth::SimplificationRule<Pattern>> m_rules[256];
+	dev::eth::MatchGroups<Expression> m_matchGroups;
+	dev::eth::SimplificationRuleIndex<Pattern> m_rules;
 };
 
 enum class PatternKind
@@ -100,7 +100,7 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, dev::eth::MatchGroups<Expression>& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(
 		Expression const& _expr,
@@ -108,13 +108,24 @@ public:
 		std::map<YulString, Expression const*> const& _ssaValues
 	) const;
 
-	std::vector<Pattern> arguments() const { return m_arguments; }
+	std::vector<Pattern> const& arguments() const { return m_arguments; }
 
 	/// @returns the data of the matched expression if this pattern is part of a match group.
 	dev::u256 d() const;
 
 	dev::eth::Instruction instruction() const;
 
+	/// @returns the shape of the expressions this pattern can match (see SimplificationRuleIndex)
+	/// or nullopt if it matches anything.
+	std::optional<unsigned> shape() const;
+	/// @returns the shape of the expression @a _expr after resolving variables
+	/// with the given SSA values.
+	static unsigned shape(
+		Expression const& _expr,
+		Dialect const& _dialect,
+		std::map<YulString, Expression const*> const& _ssaValues
+	);
+
 	/// Turns this pattern into an actual expression. Should only be called
 	/// for patterns resulting from an action, i.e. with match groups assigned.
 	Expression toExpression(langutil::SourceLocation const& _location) const;
@@ -127,7 +138,7 @@ private:
 	std::shared_ptr<dev::u256> m_data; ///< Only valid if m_kind is Constant
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	dev::eth::MatchGroups<Expression>* m_matchGroups = nullptr;
 };
 
 }
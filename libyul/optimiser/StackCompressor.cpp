@@ -32,6 +32,8 @@
 
 #include <libyul/AsmData.h>
 
+#include <libdevcore/Common.h>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
@@ -151,6 +153,38 @@ void eliminateVariables(
 	UnusedPruner::runUntilStabilised(_dialect, _node, _allowMSizeOptimization);
 }
 
+/// Runs the compilability checker on the main block (denoted by the empty name) and the
+/// functions of the given set only. The code of the other functions is removed for the
+/// duration of the check, which is fine because the stack layout of each function (and of
+/// the main block) only depends on its own code.
+map<YulString, int> checkFunctions(
+	Dialect const& _dialect,
+	Object& _object,
+	bool _optimizeStackAllocation,
+	set<YulString> const& _functions
+)
+{
+	vector<Block*> removedBodies;
+	if (!_functions.count(YulString{}))
+		removedBodies.push_back(&boost::get<Block>(_object.code->statements.at(0)));
+	for (size_t i = 1; i < _object.code->statements.size(); ++i)
+	{
+		FunctionDefinition& fun = boost::get<FunctionDefinition>(_object.code->statements[i]);
+		if (!_functions.count(fun.name))
+			removedBodies.push_back(&fun.body);
+	}
+
+	vector<vector<Statement>> savedStatements(removedBodies.size());
+	for (size_t i = 0; i < removedBodies.size(); ++i)
+		swap(removedBodies[i]->statements, savedStatements[i]);
+	ScopeGuard restoreBodies{[&]() {
+		for (size_t i = 0; i < removedBodies.size(); ++i)
+			swap(removedBodies[i]->statements, savedStatements[i]);
+	}};
+
+	return CompilabilityChecker::run(_dialect, _object, _optimizeStackAllocation);
+}
+
 }
 
 bool StackCompressor::run(
@@ -166,9 +200,20 @@ bool StackCompressor::run(
 		"Need to run the function grouper before the stack compressor."
 	);
 	bool allowMSizeOptimzation = !MSizeFinder::containsMSize(_dialect, *_object.code);
+	map<YulString, int> stackSurplus;
 	for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 	{
-		map<YulString, int> stackSurplus = CompilabilityChecker::run(_dialect, _object, _optimizeStackAllocation);
+		if (iterations == 0)
+			stackSurplus = CompilabilityChecker::run(_dialect, _object, _optimizeStackAllocation);
+		else
+		{
+			// Only the code with a surplus has been modified in the previous iteration,
+			// all other functions are still known to be compilable.
+			set<YulString> modified;
+			for (auto const& surplus: stackSurplus)
+				modified.insert(surplus.first);
+			stackSurplus = checkFunctions(_dialect, _object, _optimizeStackAllocation, modified);
+		}
 		if (stackSurplus.empty())
 			return true;
 
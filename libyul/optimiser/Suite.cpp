@@ -64,6 +64,9 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libdevcore/CommonData.h>
+#include <libdevcore/Profiler.h>
+
+#include <cctype>
 
 using namespace std;
 using namespace dev;
@@ -74,9 +77,12 @@ void OptimiserSuite::run(
 	GasMeter const* _meter,
 	Object& _object,
 	bool _optimizeStackAllocation,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	CallSiteCounts const* _callSiteCounts,
+	string const& _optimisationSequence
 )
 {
+	ScopedProfile profile("OptimiserSuite");
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
 	reservedIdentifiers += _dialect.fixedFunctionNames();
 
@@ -87,180 +93,18 @@ void OptimiserSuite::run(
 	)(*_object.code));
 	Block& ast = *_object.code;
 
-	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast);
-
-	suite.runSequence({
-		VarDeclInitializer::name,
-		FunctionHoister::name,
-		BlockFlattener::name,
-		ForLoopInitRewriter::name,
-		DeadCodeEliminator::name,
-		FunctionGrouper::name,
-		EquivalentFunctionCombiner::name,
-		UnusedPruner::name,
-		BlockFlattener::name,
-		ControlFlowSimplifier::name,
-		LiteralRematerialiser::name,
-		ConditionalUnsimplifier::name,
-		StructuralSimplifier::name,
-		ControlFlowSimplifier::name,
-		ForLoopConditionIntoBody::name,
-		BlockFlattener::name
-	}, ast);
-
-	// None of the above can make stack problems worse.
-
-	size_t codeSize = 0;
-	for (size_t rounds = 0; rounds < 12; ++rounds)
-	{
-		{
-			size_t newSize = CodeSize::codeSizeIncludingFunctions(ast);
-			if (newSize == codeSize)
-				break;
-			codeSize = newSize;
-		}
-
-		{
-			// Turn into SSA and simplify
-			suite.runSequence({
-				ExpressionSplitter::name,
-				SSATransform::name,
-				RedundantAssignEliminator::name,
-				RedundantAssignEliminator::name,
-				ExpressionSimplifier::name,
-				CommonSubexpressionEliminator::name,
-				LoadResolver::name
-			}, ast);
-		}
-
-		{
-			// perform structural simplification
-			suite.runSequence({
-				CommonSubexpressionEliminator::name,
-				ConditionalSimplifier::name,
-				LiteralRematerialiser::name,
-				ConditionalUnsimplifier::name,
-				StructuralSimplifier::name,
-				LiteralRematerialiser::name,
-				ForLoopConditionOutOfBody::name,
-				ControlFlowSimplifier::name,
-				StructuralSimplifier::name,
-				ControlFlowSimplifier::name,
-				BlockFlattener::name,
-				DeadCodeEliminator::name,
-				ForLoopConditionIntoBody::name,
-				UnusedPruner::name
-			}, ast);
-		}
-
-		{
-			// simplify again
-			suite.runSequence({
-				LoadResolver::name,
-				CommonSubexpressionEliminator::name,
-				UnusedPruner::name,
-			}, ast);
-		}
-
-		{
-			// reverse SSA
-			suite.runSequence({
-				SSAReverser::name,
-				CommonSubexpressionEliminator::name,
-				UnusedPruner::name,
-
-				ExpressionJoiner::name,
-				ExpressionJoiner::name,
-			}, ast);
-		}
-
-		// should have good "compilability" property here.
-
-		{
-			// run functional expression inliner
-			suite.runSequence({
-				ExpressionInliner::name,
-				UnusedPruner::name,
-			}, ast);
-		}
-
-		{
-			// Turn into SSA again and simplify
-			suite.runSequence({
-				ExpressionSplitter::name,
-				SSATransform::name,
-				RedundantAssignEliminator::name,
-				RedundantAssignEliminator::name,
-				CommonSubexpressionEliminator::name,
-				LoadResolver::name,
-			}, ast);
-		}
+	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast, _callSiteCounts);
 
-		{
-			// run full inliner
-			suite.runSequence({
-				FunctionGrouper::name,
-				EquivalentFunctionCombiner::name,
-				FullInliner::name,
-				BlockFlattener::name
-			}, ast);
-		}
-
-		{
-			// SSA plus simplify
-			suite.runSequence({
-				ConditionalSimplifier::name,
-				LiteralRematerialiser::name,
-				ConditionalUnsimplifier::name,
-				CommonSubexpressionEliminator::name,
-				SSATransform::name,
-				RedundantAssignEliminator::name,
-				RedundantAssignEliminator::name,
-				LoadResolver::name,
-				ExpressionSimplifier::name,
-				LiteralRematerialiser::name,
-				ForLoopConditionOutOfBody::name,
-				StructuralSimplifier::name,
-				BlockFlattener::name,
-				DeadCodeEliminator::name,
-				ControlFlowSimplifier::name,
-				CommonSubexpressionEliminator::name,
-				SSATransform::name,
-				RedundantAssignEliminator::name,
-				RedundantAssignEliminator::name,
-				ForLoopConditionIntoBody::name,
-				UnusedPruner::name,
-				CommonSubexpressionEliminator::name,
-			}, ast);
-		}
-	}
-
-	// Make source short and pretty.
-
-	suite.runSequence({
-		ExpressionJoiner::name,
-		Rematerialiser::name,
-		UnusedPruner::name,
-		ExpressionJoiner::name,
-		UnusedPruner::name,
-		ExpressionJoiner::name,
-		UnusedPruner::name,
-
-		SSAReverser::name,
-		CommonSubexpressionEliminator::name,
-		LiteralRematerialiser::name,
-		ForLoopConditionOutOfBody::name,
-		CommonSubexpressionEliminator::name,
-		UnusedPruner::name,
-
-		ExpressionJoiner::name,
-		Rematerialiser::name,
-		UnusedPruner::name,
-	}, ast);
+	// Several steps require hoisted and grouped functions and for loops without
+	// initialisation statements. The default sequence starts with the steps that establish
+	// this, custom sequences might not.
+	if (_optimisationSequence != dev::solidity::OptimiserSettings::DefaultYulOptimiserSteps)
+		suite.runSequence("hgo", ast);
+	suite.runSequence(_optimisationSequence, ast);
 
 	// This is a tuning parameter, but actually just prevents infinite loops.
 	size_t stackCompressorMaxIterations = 16;
-	suite.runSequence({
+	suite.runSequence(vector<string>{
 		FunctionGrouper::name
 	}, ast);
 	// We ignore the return value because we will get a much better error
@@ -294,7 +138,7 @@ void OptimiserSuite::run(
 		if (ast.statements.size() > 1 && boost::get<Block>(ast.statements.front()).statements.empty())
 			ast.statements.erase(ast.statements.begin());
 	}
-	suite.runSequence({
+	suite.runSequence(vector<string>{
 		VarNameCleaner::name
 	}, ast);
 
@@ -357,6 +201,124 @@ map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 	return instance;
 }
 
+map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
+{
+	static map<string, char> lookupTable{
+		{BlockFlattener::name, 'f'},
+		{CommonSubexpressionEliminator::name, 'c'},
+		{ConditionalSimplifier::name, 'C'},
+		{ConditionalUnsimplifier::name, 'U'},
+		{ControlFlowSimplifier::name, 'n'},
+		{DeadCodeEliminator::name, 'D'},
+		{EquivalentFunctionCombiner::name, 'v'},
+		{ExpressionInliner::name, 'e'},
+		{ExpressionJoiner::name, 'j'},
+		{ExpressionSimplifier::name, 's'},
+		{ExpressionSplitter::name, 'x'},
+		{ForLoopConditionIntoBody::name, 'I'},
+		{ForLoopConditionOutOfBody::name, 'O'},
+		{ForLoopInitRewriter::name, 'o'},
+		{FullInliner::name, 'i'},
+		{FunctionGrouper::name, 'g'},
+		{FunctionHoister::name, 'h'},
+		{LiteralRematerialiser::name, 'T'},
+		{LoadResolver::name, 'L'},
+		{RedundantAssignEliminator::name, 'r'},
+		{Rematerialiser::name, 'm'},
+		{SSAReverser::name, 'V'},
+		{SSATransform::name, 'a'},
+		{StructuralSimplifier::name, 't'},
+		{UnusedPruner::name, 'u'},
+		{VarDeclInitializer::name, 'd'},
+	};
+	// The variable name cleaner has no abbreviation because it does not keep the names
+	// unique, which most other steps rely on. It always runs at the end.
+	yulAssert(lookupTable.size() + 1 == allSteps().size(), "");
+	return lookupTable;
+}
+
+map<char, string> const& OptimiserSuite::stepAbbreviationToNameMap()
+{
+	static map<char, string> lookupTable = []() {
+		map<char, string> abbreviationToName;
+		for (auto const& [name, abbreviation]: stepNameToAbbreviationMap())
+			abbreviationToName[abbreviation] = name;
+		yulAssert(abbreviationToName.size() == stepNameToAbbreviationMap().size(), "Duplicate step abbreviation.");
+		return abbreviationToName;
+	}();
+	return lookupTable;
+}
+
+void OptimiserSuite::validateSequence(string const& _stepAbbreviations)
+{
+	int nestingLevel = 0;
+	for (char abbreviation: _stepAbbreviations)
+		if (abbreviation == '[')
+			++nestingLevel;
+		else if (abbreviation == ']')
+		{
+			--nestingLevel;
+			assertThrow(nestingLevel >= 0, OptimizerException, "Unbalanced brackets in optimiser sequence.");
+		}
+		else if (!isspace(static_cast<unsigned char>(abbreviation)))
+			assertThrow(
+				stepAbbreviationToNameMap().count(abbreviation),
+				OptimizerException,
+				"'" + string(1, abbreviation) + "' is not a valid optimiser step abbreviation."
+			);
+	assertThrow(nestingLevel == 0, OptimizerException, "Unbalanced brackets in optimiser sequence.");
+}
+
+void OptimiserSuite::runSequence(string const& _stepAbbreviations, Block& _ast)
+{
+	validateSequence(_stepAbbreviations);
+	runValidatedSequence(_stepAbbreviations, _ast);
+}
+
+void OptimiserSuite::runValidatedSequence(string const& _stepAbbreviations, Block& _ast)
+{
+	vector<string> steps;
+	for (size_t i = 0; i < _stepAbbreviations.size(); ++i)
+	{
+		char abbreviation = _stepAbbreviations[i];
+		if (isspace(static_cast<unsigned char>(abbreviation)))
+			continue;
+		if (abbreviation != '[')
+		{
+			steps.emplace_back(stepAbbreviationToNameMap().at(abbreviation));
+			continue;
+		}
+
+		runSequence(steps, _ast);
+		steps.clear();
+
+		size_t end = i + 1;
+		for (int nestingLevel = 1; ; ++end)
+			if (_stepAbbreviations[end] == '[')
+				++nestingLevel;
+			else if (_stepAbbreviations[end] == ']' && --nestingLevel == 0)
+				break;
+		string body = _stepAbbreviations.substr(i + 1, end - i - 1);
+		i = end;
+
+		// Note that every round processes the whole AST, even functions that did not change
+		// in the previous round: The result of the steps for a function also depends on
+		// global information (side-effects of and number of calls to other functions, inlining
+		// decisions), so it cannot be reused without changing the generated code.
+		size_t codeSize = 0;
+		for (size_t rounds = 0; rounds < c_maxRounds; ++rounds)
+		{
+			size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
+			if (newSize == codeSize)
+				break;
+			codeSize = newSize;
+
+			runValidatedSequence(body, _ast);
+		}
+	}
+	runSequence(steps, _ast);
+}
+
 void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 {
 	unique_ptr<Block> copy;
@@ -366,7 +328,10 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	{
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		{
+			ScopedProfile profile("OptimiserSuite", step.c_str());
+			allSteps().at(step)->run(m_context, _ast);
+		}
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
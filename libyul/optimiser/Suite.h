@@ -26,6 +26,9 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <map>
 #include <set>
 #include <string>
 #include <memory>
@@ -41,10 +44,23 @@ struct Object;
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
  * Only optimizes the code of the provided object, does not descend into the sub-objects.
+ *
+ * The order of the steps is given by a sequence of step abbreviations (see
+ * stepAbbreviationToNameMap()), e.g. "xarrscL". Whitespace is ignored. A part of the
+ * sequence enclosed in square brackets is repeated until it does not change the size
+ * of the code any more, but at most c_maxRounds times. Brackets can be nested.
+ * The default sequence is OptimiserSettings::DefaultYulOptimiserSteps. Other sequences
+ * are preceded by the FunctionHoister, FunctionGrouper and ForLoopInitRewriter ("hgo"),
+ * which establish the prerequisites of the other steps.
+ * The stack compressor, the constant optimiser and the variable name cleaner are not
+ * part of the sequence and always run at the end.
  */
 class OptimiserSuite
 {
 public:
+	/// Maximum number of times a bracketed part of the sequence is repeated.
+	static size_t constexpr c_maxRounds = 12;
+
 	enum class Debug
 	{
 		None,
@@ -56,25 +72,38 @@ public:
 		GasMeter const* _meter,
 		Object& _object,
 		bool _optimizeStackAllocation,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		CallSiteCounts const* _callSiteCounts = nullptr,
+		std::string const& _optimisationSequence = dev::solidity::OptimiserSettings::DefaultYulOptimiserSteps
 	);
 
+	/// Checks that the sequence of step abbreviations only refers to known steps and
+	/// has balanced brackets. Throws an OptimizerException otherwise.
+	static void validateSequence(std::string const& _stepAbbreviations);
+
 	void runSequence(std::vector<std::string> const& _steps, Block& _ast);
+	void runSequence(std::string const& _stepAbbreviations, Block& _ast);
 
 	static std::map<std::string, std::unique_ptr<OptimiserStep>> const& allSteps();
+	static std::map<std::string, char> const& stepNameToAbbreviationMap();
+	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
 	OptimiserSuite(
 		Dialect const& _dialect,
 		std::set<YulString> const& _externallyUsedIdentifiers,
 		Debug _debug,
-		Block& _ast
+		Block& _ast,
+		CallSiteCounts const* _callSiteCounts
 	):
 		m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
-		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers},
+		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers, _callSiteCounts},
 		m_debug(_debug)
 	{}
 
+	/// Runs the sequence of step abbreviations, which has to be valid.
+	void runValidatedSequence(std::string const& _stepAbbreviations, Block& _ast);
+
 	NameDispenser m_dispenser;
 	OptimiserStepContext m_context;
 	Debug m_debug;
@@ -0,0 +1,47 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Replacement of the global allocation functions that counts heap allocations for the profiler.
+ * It is only linked into the commandline compiler, so the libraries and other front-ends
+ * do not pay for it. Kept in its own file so that the compiler does not see the definitions
+ * together with inlined standard library code.
+ */
+
+#include <libdevcore/Profiler.h>
+
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+void* operator new(size_t _size)
+{
+	dev::Profiler::countAllocation();
+	if (void* memory = malloc(_size ? _size : 1))
+		return memory;
+	throw bad_alloc();
+}
+
+void operator delete(void* _memory) noexcept
+{
+	free(_memory);
+}
+
+void operator delete(void* _memory, size_t) noexcept
+{
+	free(_memory);
+}
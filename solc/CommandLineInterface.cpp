@@ -35,6 +35,7 @@
 #include <libsolidity/interface/GasEstimator.h>
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/optimiser/Suite.h>
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/GasMeter.h>
@@ -48,6 +49,7 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/Profiler.h>
 
 #include <memory>
 
@@ -107,6 +109,7 @@ static string const g_strAssemble = "assemble";
 static string const g_strAst = "ast";
 static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
 static string const g_strCombinedJson = "combined-json";
@@ -122,6 +125,7 @@ static string const g_strHelp = "help";
 static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
 static string const g_strYul = "yul";
+static string const g_strYulProfile = "yul-profile";
 static string const g_strIR = "ir";
 static string const g_strEWasm = "ewasm";
 static string const g_strLicense = "license";
@@ -136,6 +140,7 @@ static string const g_strOpcodes = "opcodes";
 static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
+static string const g_strYulOptimizations = "yul-optimizations";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strSignatureHashes = "hashes";
@@ -143,9 +148,11 @@ static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
 static string const g_strSrcMap = "srcmap";
 static string const g_strSrcMapRuntime = "srcmap-runtime";
+static string const g_strServer = "server";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strPrettyJson = "pretty-json";
+static string const g_strProfile = "profile";
 static string const g_strVersion = "version";
 static string const g_strIgnoreMissingFiles = "ignore-missing";
 static string const g_strColor = "color";
@@ -154,6 +161,7 @@ static string const g_strNewReporter = "new-reporter";
 
 static string const g_argAbi = g_strAbi;
 static string const g_argPrettyJson = g_strPrettyJson;
+static string const g_argProfile = g_strProfile;
 static string const g_argAllowPaths = g_strAllowPaths;
 static string const g_argAsm = g_strAsm;
 static string const g_argAsmJson = g_strAsmJson;
@@ -161,6 +169,7 @@ static string const g_argAssemble = g_strAssemble;
 static string const g_argAst = g_strAst;
 static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
+static string const g_argCacheDir = g_strCacheDir;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
 static string const g_argCombinedJson = g_strCombinedJson;
@@ -170,6 +179,7 @@ static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
 static string const g_argInputFile = g_strInputFile;
 static string const g_argYul = g_strYul;
+static string const g_argYulProfile = g_strYulProfile;
 static string const g_argIR = g_strIR;
 static string const g_argEWasm = g_strEWasm;
 static string const g_argLibraries = g_strLibraries;
@@ -182,8 +192,10 @@ static string const g_argNatspecUser = g_strNatspecUser;
 static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
+static string const g_argYulOptimizations = g_strYulOptimizations;
 static string const g_argOutputDir = g_strOutputDir;
 static string const g_argSignatureHashes = g_strSignatureHashes;
+static string const g_argServer = g_strServer;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStrictAssembly = g_strStrictAssembly;
 static string const g_argVersion = g_strVersion;
@@ -658,6 +670,13 @@ Allowed options)",
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
 		(g_strOptimizeYul.c_str(), "Enable Yul optimizer in Solidity, mostly for ABIEncoderV2. Still considered experimental.")
+		(
+			g_argYulOptimizations.c_str(),
+			po::value<string>()->value_name("steps"),
+			"Forces Yul optimizer to use the specified sequence of optimization steps instead of the built-in one. "
+			"Steps are given by their abbreviations, parts enclosed in square brackets are repeated until the code "
+			"size does not change any more."
+		)
 		(g_argPrettyJson.c_str(), "Output JSON in pretty format. Currently it only works with the combined JSON output.")
 		(
 			g_argLibraries.c_str(),
@@ -678,11 +697,28 @@ Allowed options)",
 			"Output a single json document containing the specified information."
 		)
 		(g_argGas.c_str(), "Print an estimate of the maximal gas usage for each function.")
+		(
+			g_argProfile.c_str(),
+			"Print a JSON report of the wall and CPU time, heap allocations, page faults and "
+			"peak memory growth of the individual compiler phases to stderr."
+		)
 		(
 			g_argStandardJSON.c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input and provides the result on the standard output."
 		)
+		(
+			g_argServer.c_str(),
+			"Switch to Standard JSON server mode, ignoring all options except --allow-paths and --cache-dir. "
+			"It reads one Standard JSON input per line from standard input and writes the output for each "
+			"of them as a single line to standard output until the input is closed."
+		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Cache the outputs of individual contracts in the given directory and re-use them "
+			"for unchanged contracts. Only used in Standard JSON and server mode."
+		)
 		(
 			g_argAssemble.c_str(),
 			"Switch to assembly mode, ignoring all options except --machine and --optimize and assumes input is assembly."
@@ -700,6 +736,13 @@ Allowed options)",
 			po::value<string>()->value_name(boost::join(g_machineArgs, ",")),
 			"Target machine in assembly or Yul mode."
 		)
+		(
+			g_argYulProfile.c_str(),
+			po::value<string>()->value_name("file"),
+			"Use the execution counts of function calls in the given file (as written by yulrun --profile) "
+			"to guide function inlining when optimizing in strict assembly mode. "
+			"The profile has to be recorded for the same input files with the same content."
+		)
 		(
 			g_argLink.c_str(),
 			"Switch to linker mode, ignoring all options apart from --libraries "
@@ -799,6 +842,9 @@ Allowed options)",
 
 bool CommandLineInterface::processInput()
 {
+	if (m_args.count(g_argProfile))
+		Profiler::instance().setEnabled(true);
+
 	ReadCallback::Callback fileReader = [this](string const& _path)
 	{
 		try
@@ -857,11 +903,23 @@ bool CommandLineInterface::processInput()
 		}
 	}
 
-	if (m_args.count(g_argStandardJSON))
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_argServer))
 	{
-		string input = dev::readStandardInput();
 		StandardCompiler compiler(fileReader);
-		sout() << compiler.compile(std::move(input)) << endl;
+		if (m_args.count(g_argCacheDir))
+			compiler.setCacheDirectory(m_args[g_argCacheDir].as<string>());
+		if (m_args.count(g_argServer))
+		{
+			// The compiler is kept alive between the requests, so that they do not
+			// pay for the process startup and unchanged sources are not analyzed again.
+			compiler.keepCompilerStack();
+			string input;
+			while (getline(cin, input))
+				if (!boost::trim_copy(input).empty())
+					sout() << compiler.compile(input) << endl;
+		}
+		else
+			sout() << compiler.compile(dev::readStandardInput()) << endl;
 		return true;
 	}
 
@@ -885,6 +943,25 @@ bool CommandLineInterface::processInput()
 		m_evmVersion = *versionOption;
 	}
 
+	if (m_args.count(g_argYulOptimizations))
+	{
+		bool assemblyMode = m_args.count(g_argAssemble) || m_args.count(g_argStrictAssembly) || m_args.count(g_argYul);
+		if (!m_args.count(g_strOptimizeYul) && !(assemblyMode && m_args.count(g_argOptimize)))
+		{
+			serr() << "Option --" << g_argYulOptimizations << " is invalid if the Yul optimizer is disabled." << endl;
+			return false;
+		}
+		try
+		{
+			yul::OptimiserSuite::validateSequence(m_args[g_argYulOptimizations].as<string>());
+		}
+		catch (yul::OptimizerException const& _exception)
+		{
+			serr() << "Invalid optimizer step sequence in --" << g_argYulOptimizations << ": " << *boost::get_error_info<errinfo_comment>(_exception) << endl;
+			return false;
+		}
+	}
+
 	if (m_args.count(g_argAssemble) || m_args.count(g_argStrictAssembly) || m_args.count(g_argYul))
 	{
 		// switch to assembly mode
@@ -920,11 +997,48 @@ bool CommandLineInterface::processInput()
 				endl;
 			return false;
 		}
+		map<string, yul::CallSiteCounts> callSiteCounts;
+		if (m_args.count(g_argYulProfile))
+		{
+			string profileFile = m_args[g_argYulProfile].as<string>();
+			if (!optimize)
+			{
+				serr() << "Option --" << g_argYulProfile << " can only be used together with --" << g_argOptimize << "." << endl;
+				return false;
+			}
+			if (!boost::filesystem::is_regular_file(profileFile))
+			{
+				serr() << "Profile file \"" << profileFile << "\" not found." << endl;
+				return false;
+			}
+			std::optional<yul::CallSiteProfile> profile = yul::callSiteProfileFromJson(dev::readFileAsString(profileFile));
+			if (!profile)
+			{
+				serr() << "Invalid profile file \"" << profileFile << "\"." << endl;
+				return false;
+			}
+			for (auto const& sourceHash: profile->sourceHashes)
+				if (!m_sourceCodes.count(sourceHash.first))
+				{
+					serr() << "Profile file \"" << profileFile << "\" refers to \"" << sourceHash.first << "\", which is not an input." << endl;
+					return false;
+				}
+			for (auto const& src: m_sourceCodes)
+			{
+				std::optional<yul::CallSiteCounts> counts = yul::callSiteCountsForSource(*profile, src.first, src.second);
+				if (!counts)
+				{
+					serr() << "Profile file \"" << profileFile << "\" was not recorded for the current content of \"" << src.first << "\"." << endl;
+					return false;
+				}
+				callSiteCounts[src.first] = move(*counts);
+			}
+		}
 		serr() <<
 			"Warning: Yul and its optimizer are still experimental. Please use the output with care." <<
 			endl;
 
-		return assemble(inputLanguage, targetMachine, optimize);
+		return assemble(inputLanguage, targetMachine, optimize, callSiteCounts);
 	}
 	if (m_args.count(g_argLink))
 	{
@@ -961,6 +1075,8 @@ bool CommandLineInterface::processInput()
 		settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
 		settings.runYulOptimiser = m_args.count(g_strOptimizeYul);
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
+		if (m_args.count(g_argYulOptimizations))
+			settings.yulOptimiserSteps = m_args[g_argYulOptimizations].as<string>();
 		m_compiler->setOptimiserSettings(settings);
 
 		bool successful = m_compiler->compile();
@@ -1188,14 +1304,25 @@ void CommandLineInterface::handleAst(string const& _argStr)
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	bool success = true;
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_argServer) || m_onlyAssemble)
+	{
 		// Already done in "processInput" phase.
-		return true;
+	}
 	else if (m_onlyLink)
+	{
 		writeLinkedFiles();
+		success = !m_error;
+	}
 	else
+	{
 		outputCompilationResults();
-	return !m_error;
+		success = !m_error;
+	}
+
+	if (m_args.count(g_argProfile))
+		serr() << dev::jsonPrettyPrint(Profiler::instance().report()) << endl;
+	return success;
 }
 
 bool CommandLineInterface::link()
@@ -1289,18 +1416,24 @@ string CommandLineInterface::objectWithLinkRefsHex(eth::LinkerObject const& _obj
 bool CommandLineInterface::assemble(
 	yul::AssemblyStack::Language _language,
 	yul::AssemblyStack::Machine _targetMachine,
-	bool _optimize
+	bool _optimize,
+	map<string, yul::CallSiteCounts> const& _callSiteCounts
 )
 {
 	bool successful = true;
+	OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
+	if (_optimize && m_args.count(g_argYulOptimizations))
+		settings.yulOptimiserSteps = m_args[g_argYulOptimizations].as<string>();
 	map<string, yul::AssemblyStack> assemblyStacks;
 	for (auto const& src: m_sourceCodes)
 	{
 		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(
 			m_evmVersion,
 			_language,
-			_optimize ? OptimiserSettings::full() : OptimiserSettings::minimal()
+			settings
 		);
+		if (_callSiteCounts.count(src.first))
+			stack.setCallSiteCounts(_callSiteCounts.at(src.first));
 		try
 		{
 			if (!stack.parseAndAnalyze(src.first, src.second))
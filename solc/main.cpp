@@ -21,6 +21,7 @@
  */
 
 #include <solc/CommandLineInterface.h>
+#include <libdevcore/Profiler.h>
 #include <boost/exception/all.hpp>
 #include <clocale>
 #include <iostream>
@@ -53,6 +54,7 @@ static void setDefaultOrCLocale()
 int main(int argc, char** argv)
 {
 	setDefaultOrCLocale();
+	dev::Profiler::instance().setCountsAllocations(true);
 	dev::solidity::CommandLineInterface cli;
 	if (!cli.parseArguments(argc, argv))
 		return 1;
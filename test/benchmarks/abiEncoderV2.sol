@@ -0,0 +1,199 @@
+pragma solidity >=0.5.0;
+pragma experimental ABIEncoderV2;
+
+// Exercises the ABIEncoderV2 code generation: nested structs, dynamic
+// arrays of structs, multi-dimensional arrays, calldata and memory
+// decoding, events and abi.encode / abi.decode.
+
+contract Types {
+	enum Side { Buy, Sell }
+	enum Status { Open, Filled, Cancelled, Expired }
+
+	struct Asset {
+		address token;
+		uint256 id;
+		bytes data;
+	}
+
+	struct Fee {
+		address recipient;
+		uint16 basisPoints;
+		bool paidInNative;
+	}
+
+	struct Order {
+		address maker;
+		address taker;
+		Side side;
+		Asset makerAsset;
+		Asset takerAsset;
+		uint128 makerAmount;
+		uint128 takerAmount;
+		uint64 expiry;
+		uint64 salt;
+		Fee[] fees;
+		bytes32[] tags;
+	}
+
+	struct Signature {
+		uint8 v;
+		bytes32 r;
+		bytes32 s;
+	}
+
+	struct Fill {
+		bytes32 orderHash;
+		uint128 filled;
+		Status status;
+		uint256[2][] partials;
+	}
+
+	struct Batch {
+		Order[] orders;
+		Signature[] signatures;
+		string memo;
+		uint256[][] amounts;
+	}
+}
+
+contract OrderBook is Types {
+	event OrderPlaced(bytes32 indexed hash, Order order);
+	event OrderFilled(bytes32 indexed hash, Fill fill, Fee[] fees);
+	event BatchSettled(uint256 count, bytes32[] hashes, string memo);
+
+	mapping(bytes32 => Fill) internal fills;
+	mapping(address => uint256) public nonces;
+	Order[] internal orders;
+	Fee[] internal defaultFees;
+
+	function hashOrder(Order memory _order) public pure returns (bytes32) {
+		return keccak256(abi.encode(_order));
+	}
+
+	function hashAsset(Asset memory _asset) public pure returns (bytes32) {
+		return keccak256(abi.encode(_asset.token, _asset.id, _asset.data));
+	}
+
+	function place(Order memory _order, Signature memory _signature) public returns (bytes32 hash) {
+		Order memory order = _order;
+		hash = hashOrder(order);
+		require(ecrecover(hash, _signature.v, _signature.r, _signature.s) == order.maker, "Invalid signature.");
+		orders.length++;
+		Order storage stored = orders[orders.length - 1];
+		stored.maker = order.maker;
+		stored.taker = order.taker;
+		stored.side = order.side;
+		stored.makerAsset = order.makerAsset;
+		stored.takerAsset = order.takerAsset;
+		stored.makerAmount = order.makerAmount;
+		stored.takerAmount = order.takerAmount;
+		stored.expiry = order.expiry;
+		stored.salt = order.salt;
+		for (uint i = 0; i < order.fees.length; i++)
+			stored.fees.push(order.fees[i]);
+		stored.tags = order.tags;
+		nonces[order.maker]++;
+		emit OrderPlaced(hash, order);
+	}
+
+	function fill(bytes32 _hash, uint128 _amount, uint256[2][] memory _partials) public returns (Fill memory) {
+		Fill storage current = fills[_hash];
+		current.orderHash = _hash;
+		current.filled += _amount;
+		current.status = Status.Filled;
+		for (uint i = 0; i < _partials.length; i++)
+			current.partials.push(_partials[i]);
+		emit OrderFilled(_hash, current, defaultFees);
+		return current;
+	}
+
+	function settle(Batch memory _batch) public returns (bytes32[] memory hashes) {
+		require(_batch.orders.length == _batch.signatures.length, "Length mismatch.");
+		hashes = new bytes32[](_batch.orders.length);
+		for (uint i = 0; i < _batch.orders.length; i++)
+		{
+			Order memory order = _batch.orders[i];
+			hashes[i] = hashOrder(order);
+			Fill storage current = fills[hashes[i]];
+			current.orderHash = hashes[i];
+			for (uint j = 0; j < _batch.amounts[i].length; j++)
+				current.filled += uint128(_batch.amounts[i][j]);
+		}
+		emit BatchSettled(hashes.length, hashes, _batch.memo);
+	}
+
+	function getOrder(uint256 _index) external view returns (Order memory) {
+		return orders[_index];
+	}
+
+	function getOrders(uint256 _from, uint256 _to) external view returns (Order[] memory result) {
+		result = new Order[](_to - _from);
+		for (uint i = _from; i < _to; i++)
+			result[i - _from] = orders[i];
+	}
+
+	function getFill(bytes32 _hash) external view returns (Fill memory) {
+		return fills[_hash];
+	}
+
+	function encodeBatch(Batch memory _batch) public pure returns (bytes memory) {
+		return abi.encode(_batch, _batch.orders.length, _batch.memo);
+	}
+
+	function decodeBatch(bytes memory _data) public pure returns (Batch memory batch, uint256 count, string memory memo) {
+		(batch, count, memo) = abi.decode(_data, (Batch, uint256, string));
+	}
+
+	function roundTrip(Batch memory _batch) public pure returns (Batch memory) {
+		(Batch memory batch,,) = decodeBatch(encodeBatch(_batch));
+		return batch;
+	}
+
+	function setDefaultFees(Fee[] memory _fees) public {
+		delete defaultFees;
+		for (uint i = 0; i < _fees.length; i++)
+			defaultFees.push(_fees[i]);
+	}
+
+	function matrix(uint256[][] memory _a, uint256[][] memory _b) public pure returns (uint256[][] memory c) {
+		c = new uint256[][](_a.length);
+		for (uint i = 0; i < _a.length; i++)
+		{
+			c[i] = new uint256[](_b[0].length);
+			for (uint j = 0; j < _b[0].length; j++)
+				for (uint k = 0; k < _b.length; k++)
+					c[i][j] += _a[i][k] * _b[k][j];
+		}
+	}
+
+	function nested(string[][] memory _strings, bytes[2][] memory _bytes) public pure returns (string[][] memory, bytes[2][] memory) {
+		return (_strings, _bytes);
+	}
+}
+
+contract OrderBookClient is Types {
+	OrderBook book;
+
+	constructor(OrderBook _book) public {
+		book = _book;
+	}
+
+	function mirror(uint256 _from, uint256 _to) external view returns (Order[] memory orders, bytes32[] memory hashes) {
+		orders = book.getOrders(_from, _to);
+		hashes = new bytes32[](orders.length);
+		for (uint i = 0; i < orders.length; i++)
+			hashes[i] = book.hashOrder(orders[i]);
+	}
+
+	function forward(Batch memory _batch) public returns (bytes32[] memory) {
+		return book.settle(_batch);
+	}
+
+	function fillAll(bytes32[] calldata _hashes, uint128 _amount) external returns (Fill[] memory result) {
+		result = new Fill[](_hashes.length);
+		uint256[2][] memory partials = new uint256[2][](1);
+		partials[0] = [uint256(_amount), block.number];
+		for (uint i = 0; i < _hashes.length; i++)
+			result[i] = book.fill(_hashes[i], _amount, partials);
+	}
+}
@@ -0,0 +1,928 @@
+pragma solidity >=0.5.0;
+
+// A deep inheritance hierarchy with overridden functions, modifiers, events
+// and state variables on every level, which stresses the linearization,
+// name resolution and the contract level checks.
+
+interface IRegistry {
+	function register(address _account, uint256 _level) external returns (bool);
+	function level(address _account) external view returns (uint256);
+}
+
+contract Base {
+	address public owner;
+	uint256 public counter;
+	mapping(address => uint256) internal balances;
+
+	event Step(uint256 indexed level, address indexed caller, uint256 value);
+
+	constructor() public {
+		owner = msg.sender;
+	}
+
+	modifier onlyOwner() {
+		require(msg.sender == owner, "Not owner.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		counter += _value;
+		emit Step(0, msg.sender, _value);
+		return _value;
+	}
+
+	function describe() public pure returns (string memory) {
+		return "Base";
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return _amount / 1000;
+	}
+}
+
+contract Level1 is Base {
+	uint256 public value1;
+	mapping(address => uint256[]) internal history1;
+
+	event Level1Reached(address indexed account, uint256 total);
+
+	modifier atLeast1(uint256 _value) {
+		require(_value >= 1, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value1 += _value * 1;
+		history1[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level1Reached(msg.sender, value1);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level1"));
+	}
+
+	function only1(uint256 _value) public atLeast1(_value) onlyOwner returns (uint256) {
+		value1 = _value;
+		return history1[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 1;
+	}
+}
+
+contract Level2 is Level1 {
+	uint256 public value2;
+	mapping(address => uint256[]) internal history2;
+
+	event Level2Reached(address indexed account, uint256 total);
+
+	modifier atLeast2(uint256 _value) {
+		require(_value >= 2, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value2 += _value * 2;
+		history2[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level2Reached(msg.sender, value2);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level2"));
+	}
+
+	function only2(uint256 _value) public atLeast2(_value) onlyOwner returns (uint256) {
+		value2 = _value;
+		return history2[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 2;
+	}
+}
+
+contract Level3 is Level2 {
+	uint256 public value3;
+	mapping(address => uint256[]) internal history3;
+
+	event Level3Reached(address indexed account, uint256 total);
+
+	modifier atLeast3(uint256 _value) {
+		require(_value >= 3, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value3 += _value * 3;
+		history3[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level3Reached(msg.sender, value3);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level3"));
+	}
+
+	function only3(uint256 _value) public atLeast3(_value) onlyOwner returns (uint256) {
+		value3 = _value;
+		return history3[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 3;
+	}
+}
+
+contract Mixin1 is Base {
+	uint256 internal mixin1Total;
+
+	function step(uint256 _value) public returns (uint256) {
+		mixin1Total += _value;
+		return super.step(_value + 1);
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) + 4;
+	}
+}
+
+contract Level4 is Level3, Mixin1 {
+	uint256 public value4;
+	mapping(address => uint256[]) internal history4;
+
+	event Level4Reached(address indexed account, uint256 total);
+
+	modifier atLeast4(uint256 _value) {
+		require(_value >= 4, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value4 += _value * 4;
+		history4[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level4Reached(msg.sender, value4);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level4"));
+	}
+
+	function only4(uint256 _value) public atLeast4(_value) onlyOwner returns (uint256) {
+		value4 = _value;
+		return history4[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 4;
+	}
+}
+
+contract Level5 is Level4 {
+	uint256 public value5;
+	mapping(address => uint256[]) internal history5;
+
+	event Level5Reached(address indexed account, uint256 total);
+
+	modifier atLeast5(uint256 _value) {
+		require(_value >= 5, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value5 += _value * 5;
+		history5[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level5Reached(msg.sender, value5);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level5"));
+	}
+
+	function only5(uint256 _value) public atLeast5(_value) onlyOwner returns (uint256) {
+		value5 = _value;
+		return history5[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 5;
+	}
+}
+
+contract Level6 is Level5 {
+	uint256 public value6;
+	mapping(address => uint256[]) internal history6;
+
+	event Level6Reached(address indexed account, uint256 total);
+
+	modifier atLeast6(uint256 _value) {
+		require(_value >= 6, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value6 += _value * 6;
+		history6[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level6Reached(msg.sender, value6);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level6"));
+	}
+
+	function only6(uint256 _value) public atLeast6(_value) onlyOwner returns (uint256) {
+		value6 = _value;
+		return history6[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 6;
+	}
+}
+
+contract Level7 is Level6 {
+	uint256 public value7;
+	mapping(address => uint256[]) internal history7;
+
+	event Level7Reached(address indexed account, uint256 total);
+
+	modifier atLeast7(uint256 _value) {
+		require(_value >= 7, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value7 += _value * 7;
+		history7[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level7Reached(msg.sender, value7);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level7"));
+	}
+
+	function only7(uint256 _value) public atLeast7(_value) onlyOwner returns (uint256) {
+		value7 = _value;
+		return history7[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 7;
+	}
+}
+
+contract Mixin2 is Base {
+	uint256 internal mixin2Total;
+
+	function step(uint256 _value) public returns (uint256) {
+		mixin2Total += _value;
+		return super.step(_value + 1);
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) + 8;
+	}
+}
+
+contract Level8 is Level7, Mixin2 {
+	uint256 public value8;
+	mapping(address => uint256[]) internal history8;
+
+	event Level8Reached(address indexed account, uint256 total);
+
+	modifier atLeast8(uint256 _value) {
+		require(_value >= 8, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value8 += _value * 8;
+		history8[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level8Reached(msg.sender, value8);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level8"));
+	}
+
+	function only8(uint256 _value) public atLeast8(_value) onlyOwner returns (uint256) {
+		value8 = _value;
+		return history8[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 8;
+	}
+}
+
+contract Level9 is Level8 {
+	uint256 public value9;
+	mapping(address => uint256[]) internal history9;
+
+	event Level9Reached(address indexed account, uint256 total);
+
+	modifier atLeast9(uint256 _value) {
+		require(_value >= 9, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value9 += _value * 9;
+		history9[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level9Reached(msg.sender, value9);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level9"));
+	}
+
+	function only9(uint256 _value) public atLeast9(_value) onlyOwner returns (uint256) {
+		value9 = _value;
+		return history9[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 9;
+	}
+}
+
+contract Level10 is Level9 {
+	uint256 public value10;
+	mapping(address => uint256[]) internal history10;
+
+	event Level10Reached(address indexed account, uint256 total);
+
+	modifier atLeast10(uint256 _value) {
+		require(_value >= 10, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value10 += _value * 10;
+		history10[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level10Reached(msg.sender, value10);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level10"));
+	}
+
+	function only10(uint256 _value) public atLeast10(_value) onlyOwner returns (uint256) {
+		value10 = _value;
+		return history10[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 10;
+	}
+}
+
+contract Level11 is Level10 {
+	uint256 public value11;
+	mapping(address => uint256[]) internal history11;
+
+	event Level11Reached(address indexed account, uint256 total);
+
+	modifier atLeast11(uint256 _value) {
+		require(_value >= 11, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value11 += _value * 11;
+		history11[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level11Reached(msg.sender, value11);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level11"));
+	}
+
+	function only11(uint256 _value) public atLeast11(_value) onlyOwner returns (uint256) {
+		value11 = _value;
+		return history11[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 11;
+	}
+}
+
+contract Mixin3 is Base {
+	uint256 internal mixin3Total;
+
+	function step(uint256 _value) public returns (uint256) {
+		mixin3Total += _value;
+		return super.step(_value + 1);
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) + 12;
+	}
+}
+
+contract Level12 is Level11, Mixin3 {
+	uint256 public value12;
+	mapping(address => uint256[]) internal history12;
+
+	event Level12Reached(address indexed account, uint256 total);
+
+	modifier atLeast12(uint256 _value) {
+		require(_value >= 12, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value12 += _value * 12;
+		history12[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level12Reached(msg.sender, value12);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level12"));
+	}
+
+	function only12(uint256 _value) public atLeast12(_value) onlyOwner returns (uint256) {
+		value12 = _value;
+		return history12[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 12;
+	}
+}
+
+contract Level13 is Level12 {
+	uint256 public value13;
+	mapping(address => uint256[]) internal history13;
+
+	event Level13Reached(address indexed account, uint256 total);
+
+	modifier atLeast13(uint256 _value) {
+		require(_value >= 13, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value13 += _value * 13;
+		history13[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level13Reached(msg.sender, value13);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level13"));
+	}
+
+	function only13(uint256 _value) public atLeast13(_value) onlyOwner returns (uint256) {
+		value13 = _value;
+		return history13[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 13;
+	}
+}
+
+contract Level14 is Level13 {
+	uint256 public value14;
+	mapping(address => uint256[]) internal history14;
+
+	event Level14Reached(address indexed account, uint256 total);
+
+	modifier atLeast14(uint256 _value) {
+		require(_value >= 14, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value14 += _value * 14;
+		history14[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level14Reached(msg.sender, value14);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level14"));
+	}
+
+	function only14(uint256 _value) public atLeast14(_value) onlyOwner returns (uint256) {
+		value14 = _value;
+		return history14[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 14;
+	}
+}
+
+contract Level15 is Level14 {
+	uint256 public value15;
+	mapping(address => uint256[]) internal history15;
+
+	event Level15Reached(address indexed account, uint256 total);
+
+	modifier atLeast15(uint256 _value) {
+		require(_value >= 15, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value15 += _value * 15;
+		history15[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level15Reached(msg.sender, value15);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level15"));
+	}
+
+	function only15(uint256 _value) public atLeast15(_value) onlyOwner returns (uint256) {
+		value15 = _value;
+		return history15[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 15;
+	}
+}
+
+contract Mixin4 is Base {
+	uint256 internal mixin4Total;
+
+	function step(uint256 _value) public returns (uint256) {
+		mixin4Total += _value;
+		return super.step(_value + 1);
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) + 16;
+	}
+}
+
+contract Level16 is Level15, Mixin4 {
+	uint256 public value16;
+	mapping(address => uint256[]) internal history16;
+
+	event Level16Reached(address indexed account, uint256 total);
+
+	modifier atLeast16(uint256 _value) {
+		require(_value >= 16, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value16 += _value * 16;
+		history16[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level16Reached(msg.sender, value16);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level16"));
+	}
+
+	function only16(uint256 _value) public atLeast16(_value) onlyOwner returns (uint256) {
+		value16 = _value;
+		return history16[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 16;
+	}
+}
+
+contract Level17 is Level16 {
+	uint256 public value17;
+	mapping(address => uint256[]) internal history17;
+
+	event Level17Reached(address indexed account, uint256 total);
+
+	modifier atLeast17(uint256 _value) {
+		require(_value >= 17, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value17 += _value * 17;
+		history17[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level17Reached(msg.sender, value17);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level17"));
+	}
+
+	function only17(uint256 _value) public atLeast17(_value) onlyOwner returns (uint256) {
+		value17 = _value;
+		return history17[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 17;
+	}
+}
+
+contract Level18 is Level17 {
+	uint256 public value18;
+	mapping(address => uint256[]) internal history18;
+
+	event Level18Reached(address indexed account, uint256 total);
+
+	modifier atLeast18(uint256 _value) {
+		require(_value >= 18, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value18 += _value * 18;
+		history18[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level18Reached(msg.sender, value18);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level18"));
+	}
+
+	function only18(uint256 _value) public atLeast18(_value) onlyOwner returns (uint256) {
+		value18 = _value;
+		return history18[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 18;
+	}
+}
+
+contract Level19 is Level18 {
+	uint256 public value19;
+	mapping(address => uint256[]) internal history19;
+
+	event Level19Reached(address indexed account, uint256 total);
+
+	modifier atLeast19(uint256 _value) {
+		require(_value >= 19, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value19 += _value * 19;
+		history19[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level19Reached(msg.sender, value19);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level19"));
+	}
+
+	function only19(uint256 _value) public atLeast19(_value) onlyOwner returns (uint256) {
+		value19 = _value;
+		return history19[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 19;
+	}
+}
+
+contract Mixin5 is Base {
+	uint256 internal mixin5Total;
+
+	function step(uint256 _value) public returns (uint256) {
+		mixin5Total += _value;
+		return super.step(_value + 1);
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) + 20;
+	}
+}
+
+contract Level20 is Level19, Mixin5 {
+	uint256 public value20;
+	mapping(address => uint256[]) internal history20;
+
+	event Level20Reached(address indexed account, uint256 total);
+
+	modifier atLeast20(uint256 _value) {
+		require(_value >= 20, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value20 += _value * 20;
+		history20[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level20Reached(msg.sender, value20);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level20"));
+	}
+
+	function only20(uint256 _value) public atLeast20(_value) onlyOwner returns (uint256) {
+		value20 = _value;
+		return history20[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 20;
+	}
+}
+
+contract Level21 is Level20 {
+	uint256 public value21;
+	mapping(address => uint256[]) internal history21;
+
+	event Level21Reached(address indexed account, uint256 total);
+
+	modifier atLeast21(uint256 _value) {
+		require(_value >= 21, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value21 += _value * 21;
+		history21[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level21Reached(msg.sender, value21);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level21"));
+	}
+
+	function only21(uint256 _value) public atLeast21(_value) onlyOwner returns (uint256) {
+		value21 = _value;
+		return history21[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 21;
+	}
+}
+
+contract Level22 is Level21 {
+	uint256 public value22;
+	mapping(address => uint256[]) internal history22;
+
+	event Level22Reached(address indexed account, uint256 total);
+
+	modifier atLeast22(uint256 _value) {
+		require(_value >= 22, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value22 += _value * 22;
+		history22[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level22Reached(msg.sender, value22);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level22"));
+	}
+
+	function only22(uint256 _value) public atLeast22(_value) onlyOwner returns (uint256) {
+		value22 = _value;
+		return history22[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 22;
+	}
+}
+
+contract Level23 is Level22 {
+	uint256 public value23;
+	mapping(address => uint256[]) internal history23;
+
+	event Level23Reached(address indexed account, uint256 total);
+
+	modifier atLeast23(uint256 _value) {
+		require(_value >= 23, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value23 += _value * 23;
+		history23[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level23Reached(msg.sender, value23);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level23"));
+	}
+
+	function only23(uint256 _value) public atLeast23(_value) onlyOwner returns (uint256) {
+		value23 = _value;
+		return history23[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 23;
+	}
+}
+
+contract Mixin6 is Base {
+	uint256 internal mixin6Total;
+
+	function step(uint256 _value) public returns (uint256) {
+		mixin6Total += _value;
+		return super.step(_value + 1);
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) + 24;
+	}
+}
+
+contract Level24 is Level23, Mixin6 {
+	uint256 public value24;
+	mapping(address => uint256[]) internal history24;
+
+	event Level24Reached(address indexed account, uint256 total);
+
+	modifier atLeast24(uint256 _value) {
+		require(_value >= 24, "Value too small.");
+		_;
+	}
+
+	function step(uint256 _value) public returns (uint256) {
+		value24 += _value * 24;
+		history24[msg.sender].push(_value);
+		balances[msg.sender] += fee(_value);
+		emit Level24Reached(msg.sender, value24);
+		return super.step(_value) + 1;
+	}
+
+	function describe() public pure returns (string memory) {
+		return string(abi.encodePacked(super.describe(), "/Level24"));
+	}
+
+	function only24(uint256 _value) public atLeast24(_value) onlyOwner returns (uint256) {
+		value24 = _value;
+		return history24[msg.sender].length;
+	}
+
+	function fee(uint256 _amount) internal pure returns (uint256) {
+		return super.fee(_amount) * 2 + 24;
+	}
+}
+
+contract Final is Level24 {
+	IRegistry internal registry;
+
+	constructor(IRegistry _registry) public {
+		registry = _registry;
+	}
+
+	function step(uint256 _value) public returns (uint256 result) {
+		result = super.step(_value);
+		registry.register(msg.sender, 24);
+	}
+
+	function level(address _account) external view returns (uint256) {
+		return registry.level(_account);
+	}
+}
@@ -0,0 +1,345 @@
+pragma solidity >=0.5.0;
+
+// Large libraries with internal and public functions, attached via
+// "using for", inline assembly and loops, which stresses type checking,
+// code generation of internal calls and the legacy optimizer.
+
+library SafeMath {
+	function add(uint256 a, uint256 b) internal pure returns (uint256 c) {
+		c = a + b;
+		require(c >= a, "Addition overflow.");
+	}
+
+	function sub(uint256 a, uint256 b) internal pure returns (uint256) {
+		require(b <= a, "Subtraction underflow.");
+		return a - b;
+	}
+
+	function mul(uint256 a, uint256 b) internal pure returns (uint256 c) {
+		if (a == 0)
+			return 0;
+		c = a * b;
+		require(c / a == b, "Multiplication overflow.");
+	}
+
+	function div(uint256 a, uint256 b) internal pure returns (uint256) {
+		require(b > 0, "Division by zero.");
+		return a / b;
+	}
+
+	function mod(uint256 a, uint256 b) internal pure returns (uint256) {
+		require(b != 0, "Modulo by zero.");
+		return a % b;
+	}
+
+	function min(uint256 a, uint256 b) internal pure returns (uint256) {
+		return a < b ? a : b;
+	}
+
+	function max(uint256 a, uint256 b) internal pure returns (uint256) {
+		return a > b ? a : b;
+	}
+}
+
+library FixedPoint {
+	using SafeMath for uint256;
+
+	uint256 constant ONE = 10**18;
+	uint256 constant LN2 = 693147180559945309;
+
+	function mulDown(uint256 a, uint256 b) internal pure returns (uint256) {
+		return a.mul(b) / ONE;
+	}
+
+	function mulUp(uint256 a, uint256 b) internal pure returns (uint256) {
+		uint256 product = a.mul(b);
+		return product == 0 ? 0 : (product - 1) / ONE + 1;
+	}
+
+	function divDown(uint256 a, uint256 b) internal pure returns (uint256) {
+		return a.mul(ONE).div(b);
+	}
+
+	function divUp(uint256 a, uint256 b) internal pure returns (uint256) {
+		if (a == 0)
+			return 0;
+		return (a.mul(ONE) - 1).div(b) + 1;
+	}
+
+	function powInt(uint256 x, uint256 n) internal pure returns (uint256 z) {
+		z = n % 2 != 0 ? x : ONE;
+		for (n /= 2; n != 0; n /= 2)
+		{
+			x = mulDown(x, x);
+			if (n % 2 != 0)
+				z = mulDown(z, x);
+		}
+	}
+
+	function sqrt(uint256 x) internal pure returns (uint256 y) {
+		if (x == 0)
+			return 0;
+		uint256 z = x.add(1) / 2;
+		y = x;
+		while (z < y)
+		{
+			y = z;
+			z = (x / z + z) / 2;
+		}
+	}
+
+	function binaryLog(uint256 x) internal pure returns (uint256 result) {
+		require(x >= ONE, "Argument too small.");
+		uint256 n = x / ONE;
+		while (n >= 2)
+		{
+			n >>= 1;
+			result += ONE;
+		}
+		uint256 y = x >> (result / ONE);
+		if (y == ONE)
+			return result;
+		for (uint256 delta = ONE / 2; delta > 0; delta >>= 1)
+		{
+			y = mulDown(y, y);
+			if (y >= 2 * ONE)
+			{
+				result += delta;
+				y /= 2;
+			}
+		}
+	}
+
+	function ln(uint256 x) internal pure returns (uint256) {
+		return mulDown(binaryLog(x), LN2);
+	}
+
+	function exp(uint256 x) internal pure returns (uint256 result) {
+		result = ONE;
+		uint256 term = ONE;
+		for (uint256 i = 1; i < 32 && term > 0; i++)
+		{
+			term = mulDown(term, x) / i;
+			result = result.add(term);
+		}
+	}
+}
+
+library Bytes {
+	function concat(bytes memory a, bytes memory b) internal pure returns (bytes memory result) {
+		result = new bytes(a.length + b.length);
+		uint256 i;
+		for (; i < a.length; i++)
+			result[i] = a[i];
+		for (uint256 j = 0; j < b.length; j++)
+			result[i + j] = b[j];
+	}
+
+	function slice(bytes memory data, uint256 start, uint256 length) internal pure returns (bytes memory result) {
+		require(start + length <= data.length, "Slice out of bounds.");
+		result = new bytes(length);
+		assembly {
+			let src := add(add(data, 0x20), start)
+			let dst := add(result, 0x20)
+			for { let i := 0 } lt(i, length) { i := add(i, 0x20) } {
+				mstore(add(dst, i), mload(add(src, i)))
+			}
+		}
+	}
+
+	function toUint256(bytes memory data, uint256 offset) internal pure returns (uint256 result) {
+		require(offset + 32 <= data.length, "Read out of bounds.");
+		assembly {
+			result := mload(add(add(data, 0x20), offset))
+		}
+	}
+
+	function toAddress(bytes memory data, uint256 offset) internal pure returns (address result) {
+		require(offset + 20 <= data.length, "Read out of bounds.");
+		assembly {
+			result := div(mload(add(add(data, 0x20), offset)), 0x1000000000000000000000000)
+		}
+	}
+
+	function equal(bytes memory a, bytes memory b) internal pure returns (bool) {
+		return a.length == b.length && keccak256(a) == keccak256(b);
+	}
+
+	function toHex(bytes memory data) internal pure returns (string memory) {
+		bytes memory alphabet = "0123456789abcdef";
+		bytes memory result = new bytes(2 + data.length * 2);
+		result[0] = "0";
+		result[1] = "x";
+		for (uint256 i = 0; i < data.length; i++)
+		{
+			result[2 + i * 2] = alphabet[uint8(data[i] >> 4)];
+			result[3 + i * 2] = alphabet[uint8(data[i] & 0x0f)];
+		}
+		return string(result);
+	}
+
+	function reverse(bytes memory data) internal pure returns (bytes memory result) {
+		result = new bytes(data.length);
+		for (uint256 i = 0; i < data.length; i++)
+			result[i] = data[data.length - 1 - i];
+	}
+}
+
+library Sort {
+	function insertion(uint256[] memory data) internal pure returns (uint256[] memory) {
+		for (uint256 i = 1; i < data.length; i++)
+		{
+			uint256 key = data[i];
+			uint256 j = i;
+			while (j > 0 && data[j - 1] > key)
+			{
+				data[j] = data[j - 1];
+				j--;
+			}
+			data[j] = key;
+		}
+		return data;
+	}
+
+	function quick(uint256[] memory data, int256 left, int256 right) internal pure {
+		if (left >= right)
+			return;
+		uint256 pivot = data[uint256(left + (right - left) / 2)];
+		int256 i = left;
+		int256 j = right;
+		while (i <= j)
+		{
+			while (data[uint256(i)] < pivot)
+				i++;
+			while (pivot < data[uint256(j)])
+				j--;
+			if (i <= j)
+			{
+				(data[uint256(i)], data[uint256(j)]) = (data[uint256(j)], data[uint256(i)]);
+				i++;
+				j--;
+			}
+		}
+		quick(data, left, j);
+		quick(data, i, right);
+	}
+
+	function median(uint256[] memory data) internal pure returns (uint256) {
+		require(data.length > 0, "Empty array.");
+		quick(data, 0, int256(data.length - 1));
+		if (data.length % 2 == 1)
+			return data[data.length / 2];
+		return (data[data.length / 2 - 1] + data[data.length / 2]) / 2;
+	}
+
+	function unique(uint256[] memory sorted) internal pure returns (uint256[] memory result) {
+		if (sorted.length == 0)
+			return sorted;
+		uint256 count = 1;
+		for (uint256 i = 1; i < sorted.length; i++)
+			if (sorted[i] != sorted[i - 1])
+				count++;
+		result = new uint256[](count);
+		result[0] = sorted[0];
+		uint256 k = 1;
+		for (uint256 i = 1; i < sorted.length; i++)
+			if (sorted[i] != sorted[i - 1])
+				result[k++] = sorted[i];
+	}
+}
+
+library AddressSet {
+	struct Set {
+		address[] values;
+		mapping(address => uint256) indices;
+	}
+
+	function add(Set storage set, address value) public returns (bool) {
+		if (contains(set, value))
+			return false;
+		set.values.push(value);
+		set.indices[value] = set.values.length;
+		return true;
+	}
+
+	function remove(Set storage set, address value) public returns (bool) {
+		uint256 index = set.indices[value];
+		if (index == 0)
+			return false;
+		address last = set.values[set.values.length - 1];
+		set.values[index - 1] = last;
+		set.indices[last] = index;
+		set.values.length--;
+		delete set.indices[value];
+		return true;
+	}
+
+	function contains(Set storage set, address value) public view returns (bool) {
+		return set.indices[value] != 0;
+	}
+
+	function length(Set storage set) public view returns (uint256) {
+		return set.values.length;
+	}
+
+	function at(Set storage set, uint256 index) public view returns (address) {
+		return set.values[index];
+	}
+}
+
+contract Statistics {
+	using SafeMath for uint256;
+	using FixedPoint for uint256;
+	using Bytes for bytes;
+	using Sort for uint256[];
+	using AddressSet for AddressSet.Set;
+
+	AddressSet.Set internal members;
+	uint256[] internal samples;
+
+	function join() external returns (bool) {
+		return members.add(msg.sender);
+	}
+
+	function leave() external returns (bool) {
+		return members.remove(msg.sender);
+	}
+
+	function record(uint256 _value) external {
+		require(members.contains(msg.sender), "Not a member.");
+		samples.push(_value);
+	}
+
+	function summary() external view returns (uint256 mean, uint256 median, uint256 deviation, uint256 distinct) {
+		uint256[] memory data = samples;
+		uint256 sum;
+		for (uint256 i = 0; i < data.length; i++)
+			sum = sum.add(data[i]);
+		mean = sum.div(data.length);
+		uint256 squares;
+		for (uint256 i = 0; i < data.length; i++)
+		{
+			uint256 delta = data[i] > mean ? data[i] - mean : mean - data[i];
+			squares = squares.add(delta.mul(delta));
+		}
+		deviation = (squares / data.length).sqrt();
+		median = data.median();
+		distinct = data.unique().length;
+	}
+
+	function growth(uint256 _rate, uint256 _periods) external pure returns (uint256 compound, uint256 continuous) {
+		compound = (10**18 + _rate).powInt(_periods);
+		continuous = _rate.mul(_periods).exp();
+	}
+
+	function logarithm(uint256 _x) external pure returns (uint256, uint256) {
+		return (_x.binaryLog(), _x.ln());
+	}
+
+	function describe(bytes calldata _data) external pure returns (string memory hex_, uint256 word, address account) {
+		bytes memory data = _data;
+		hex_ = data.reverse().concat(data).toHex();
+		word = data.toUint256(0);
+		account = data.slice(12, 20).toAddress(0);
+	}
+}
@@ -304,6 +304,16 @@ printTask "Compiling various other contracts and libraries..."
     done
 )
 
+printTask "Compiling the compile-time benchmark corpus..."
+(
+    cd "$REPO_ROOT"/test/benchmarks/
+    for f in *.sol
+    do
+        echo " - $f"
+        compileFull "$f"
+    done
+)
+
 printTask "Compiling all examples from the documentation..."
 SOLTMPDIR=$(mktemp -d)
 (
@@ -432,6 +442,22 @@ SOLTMPDIR=$(mktemp -d)
     fi
 )
 
+printTask "Testing server mode..."
+(
+    set -e
+    output=$(printf '%s\n\n%s\n' \
+        '{"language": "Solidity", "sources": {"A": {"content": "contract C {}"}}}' \
+        '{"language": "Solidity", "sources": {"B": {"content": "contract D {}"}}}' \
+        | "$SOLC" --server)
+
+    # One line of output per request, in the order of the requests.
+    if [[ $(echo "$output" | wc -l) != 2 || !($(echo "$output" | sed -n 2p) =~ '"B"') ]]
+    then
+        printError "Incorrect response in server mode: $output"
+        exit 1
+    fi
+)
+
 printTask "Testing soljson via the fuzzer..."
 SOLTMPDIR=$(mktemp -d)
 (
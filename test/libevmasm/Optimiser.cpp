@@ -24,10 +24,16 @@
 
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/PeepholeOptimiser.h>
+#include <libevmasm/StackShuffleOptimiser.h>
+#include <libevmasm/DeadStoreEliminator.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/ConstantOptimiser.h>
+#include <libevmasm/ExpressionClasses.h>
+#include <libevmasm/RuleList.h>
+#include <libevmasm/SimplificationRules.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -903,9 +909,36 @@ BOOST_AUTO_TEST_CASE(peephole_pop_calldatasize)
 		Instruction::POP
 	};
 	PeepholeOptimiser peepOpt(items);
-	for (size_t i = 0; i < 3; i++)
-		BOOST_CHECK(peepOpt.optimise());
+	BOOST_CHECK(peepOpt.optimise());
 	BOOST_CHECK(items.empty());
+	BOOST_CHECK(!peepOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(peephole_pop_mulmod)
+{
+	// Replacing MULMOD POP by three POPs increases the number of items,
+	// but allows the pushes to be removed afterwards.
+	AssemblyItems items{
+		AssemblyItem(Tag, 1),
+		u256(1),
+		u256(2),
+		u256(3),
+		Instruction::MULMOD,
+		Instruction::POP,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP
+	};
+	AssemblyItems expectation{
+		AssemblyItem(Tag, 1),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP
+	};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
 }
 
 BOOST_AUTO_TEST_CASE(peephole_commutative_swap1)
@@ -1075,6 +1108,227 @@ BOOST_AUTO_TEST_CASE(peephole_iszero_iszero_jumpi)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(stack_shuffle)
+{
+	AssemblyItems items{
+		u256(1),
+		u256(2),
+		u256(3),
+		Instruction::SWAP1,
+		Instruction::POP,
+		Instruction::SWAP1,
+		Instruction::POP,
+		u256(4),
+		Instruction::DUP1,
+		Instruction::SWAP1,
+		Instruction::SWAP2,
+		Instruction::SWAP2,
+		Instruction::POP,
+		Instruction::ADD
+	};
+	AssemblyItems expectation{
+		u256(1),
+		u256(2),
+		u256(3),
+		Instruction::SWAP2,
+		Instruction::POP,
+		Instruction::POP,
+		u256(4),
+		Instruction::ADD
+	};
+	StackShuffleOptimiser shuffleOpt{items};
+	BOOST_REQUIRE(shuffleOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(!shuffleOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(simplification_rule_index)
+{
+	// The rules selected through the index of argument shapes have to yield the same first
+	// match as trying all rules with the same root instruction in order.
+	using Expression = ExpressionClasses::Expression;
+	MatchGroups<Expression> matchGroups;
+	Pattern A(Push);
+	Pattern B(Push);
+	Pattern C(Push);
+	Pattern W;
+	Pattern X;
+	Pattern Y;
+	Pattern Z;
+	A.setMatchGroup(1, matchGroups);
+	B.setMatchGroup(2, matchGroups);
+	C.setMatchGroup(3, matchGroups);
+	W.setMatchGroup(4, matchGroups);
+	X.setMatchGroup(5, matchGroups);
+	Y.setMatchGroup(6, matchGroups);
+	Z.setMatchGroup(7, matchGroups);
+	vector<SimplificationRule<Pattern>> ruleList = simplificationRuleList(A, B, C, W, X, Y, Z);
+	Rules rules;
+
+	auto describe = [](SimplificationRule<Pattern> const* _rule) -> string {
+		if (!_rule)
+			return "no match";
+		return _rule->pattern.toString() + " -> " + ExpressionTemplate(_rule->action(), SourceLocation()).toString();
+	};
+
+	ExpressionClasses classes;
+	using Id = ExpressionClasses::Id;
+	// Values without a known shape (e.g. unknown stack elements) are the "missing" arguments
+	// no pattern asks for.
+	Id x = classes.newClass(SourceLocation());
+	Id y = classes.newClass(SourceLocation());
+	vector<Id> arguments{
+		classes.find(AssemblyItem(u256(0))),
+		classes.find(AssemblyItem(u256(1))),
+		classes.find(AssemblyItem(u256(0xff))),
+		classes.find(AssemblyItem(~u256(0))),
+		x,
+		y,
+		classes.find(AssemblyItem(Instruction::NOT), {x}),
+		classes.find(AssemblyItem(Instruction::ISZERO), {x}),
+		classes.find(AssemblyItem(Instruction::ADD), {x, classes.find(AssemblyItem(u256(3)))}),
+		classes.find(AssemblyItem(Instruction::AND), {x, classes.find(AssemblyItem(u256(0xff)))}),
+		classes.find(AssemblyItem(Instruction::SHL), {classes.find(AssemblyItem(u256(8))), y}),
+		classes.find(AssemblyItem(Instruction::CALLDATALOAD), {x}),
+		classes.find(AssemblyItem(Instruction::ADDRESS))
+	};
+
+	set<Instruction> instructions;
+	for (auto const& rule: ruleList)
+		instructions.insert(rule.pattern.instruction());
+	instructions.insert(Instruction::ADDRESS);
+	instructions.insert(Instruction::CALLDATALOAD);
+
+	size_t matches = 0;
+	for (Instruction instruction: instructions)
+	{
+		size_t arity = size_t(instructionInfo(instruction).args);
+		vector<size_t> choice(arity, 0);
+		while (true)
+		{
+			Expression expression;
+			expression.item = classes.storeItem(AssemblyItem(instruction));
+			for (size_t index: choice)
+				expression.arguments.push_back(arguments[index]);
+
+			string indexed = describe(rules.findFirstMatch(expression, classes));
+
+			SimplificationRule<Pattern> const* linear = nullptr;
+			for (auto const& rule: ruleList)
+				if (rule.pattern.instruction() == instruction)
+				{
+					matchGroups.clear();
+					if (rule.pattern.matches(expression, classes) && (!rule.feasible || rule.feasible()))
+					{
+						linear = &rule;
+						break;
+					}
+				}
+			BOOST_CHECK_EQUAL(indexed, describe(linear));
+			if (linear)
+				matches++;
+
+			size_t i = 0;
+			for (; i < arity && ++choice[i] == arguments.size(); ++i)
+				choice[i] = 0;
+			if (i == arity)
+				break;
+		}
+	}
+	BOOST_CHECK(matches > 100);
+}
+
+BOOST_AUTO_TEST_CASE(stack_shuffle_sequences)
+{
+	auto best = StackShuffleOptimiser::bestSequence({Instruction::DUP2, Instruction::SWAP1, Instruction::POP});
+	BOOST_REQUIRE(best);
+	BOOST_CHECK(*best == vector<Instruction>({Instruction::POP, Instruction::DUP1}));
+	// Already optimal.
+	best = StackShuffleOptimiser::bestSequence({Instruction::SWAP1, Instruction::POP});
+	BOOST_REQUIRE(best);
+	BOOST_CHECK(*best == vector<Instruction>({Instruction::SWAP1, Instruction::POP}));
+	best = StackShuffleOptimiser::bestSequence({Instruction::SWAP3, Instruction::SWAP3});
+	BOOST_REQUIRE(best);
+	BOOST_CHECK(best->empty());
+	// The same sequence is found again after the cache is cleared.
+	StackShuffleOptimiser::clearCache();
+	best = StackShuffleOptimiser::bestSequence({Instruction::DUP2, Instruction::SWAP1, Instruction::POP});
+	BOOST_REQUIRE(best);
+	BOOST_CHECK(*best == vector<Instruction>({Instruction::POP, Instruction::DUP1}));
+}
+
+BOOST_AUTO_TEST_CASE(dead_store_across_tag)
+{
+	// The first store is overwritten behind a tag that is reached by flowing into it.
+	AssemblyItems items{
+		u256(1),
+		Instruction::DUP2,
+		Instruction::SSTORE,
+		u256(2),
+		Instruction::DUP2,
+		Instruction::MSTORE,
+		AssemblyItem(Tag, 1),
+		u256(3),
+		Instruction::DUP2,
+		Instruction::SSTORE,
+		u256(4),
+		Instruction::DUP2,
+		Instruction::MSTORE,
+		Instruction::STOP
+	};
+	AssemblyItems expectation{
+		u256(1),
+		Instruction::DUP2,
+		Instruction::POP,
+		Instruction::POP,
+		u256(2),
+		Instruction::DUP2,
+		Instruction::POP,
+		Instruction::POP,
+		AssemblyItem(Tag, 1),
+		u256(3),
+		Instruction::DUP2,
+		Instruction::SSTORE,
+		u256(4),
+		Instruction::DUP2,
+		Instruction::MSTORE,
+		Instruction::STOP
+	};
+	DeadStoreEliminator deadStoreOpt{items, false};
+	BOOST_REQUIRE(deadStoreOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(!deadStoreOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(dead_store_observed)
+{
+	vector<AssemblyItems> programs{
+		// The location might be read in between.
+		{u256(1), u256(0), Instruction::SSTORE, Instruction::DUP1, Instruction::SLOAD, u256(2), u256(0), Instruction::SSTORE},
+		{u256(1), u256(0), Instruction::MSTORE, u256(0), u256(0), Instruction::LOG0, u256(2), u256(0), Instruction::MSTORE},
+		{u256(1), u256(0), Instruction::SSTORE, u256(0), u256(0), u256(0), u256(0), u256(0), Instruction::GAS, Instruction::STATICCALL, u256(2), u256(0), Instruction::SSTORE},
+		// The second store is not executed on every path.
+		{u256(1), u256(0), Instruction::SSTORE, AssemblyItem(PushTag, 1), Instruction::CALLVALUE, Instruction::JUMPI, u256(2), u256(0), Instruction::SSTORE},
+		// Different locations.
+		{u256(1), u256(0), Instruction::MSTORE, u256(2), u256(1), Instruction::MSTORE}
+	};
+	for (AssemblyItems& items: programs)
+	{
+		DeadStoreEliminator deadStoreOpt{items, false};
+		BOOST_CHECK(!deadStoreOpt.optimise());
+	}
+	AssemblyItems items{u256(1), u256(0), Instruction::MSTORE, u256(2), u256(0), Instruction::MSTORE};
+	// The first store can influence msize.
+	BOOST_CHECK(!DeadStoreEliminator(items, true).optimise());
+	BOOST_CHECK(DeadStoreEliminator(items, false).optimise());
+}
+
 BOOST_AUTO_TEST_CASE(jumpdest_removal)
 {
 	AssemblyItems items{
@@ -1158,6 +1412,135 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(jumpdest_removal_multiple_subassemblies)
+{
+	// Same as above, but with several sub-assemblies (which are optimised concurrently)
+	// and a sub-assembly that is shared between them (which prevents that).
+
+	auto createSub = [](AssemblyPointer const& _nested)
+	{
+		AssemblyPointer sub = make_shared<Assembly>();
+		if (_nested)
+			sub->appendSubroutine(_nested);
+		sub->append(u256(1));
+		auto t1 = sub->newTag();
+		sub->append(t1);
+		sub->append(u256(2));
+		sub->append(Instruction::JUMP);
+		auto t2 = sub->newTag();
+		sub->append(t2); // Identical to T1, will be unified
+		sub->append(u256(2));
+		sub->append(Instruction::JUMP);
+		auto t3 = sub->newTag();
+		sub->append(t3); // This will be removed
+		sub->append(u256(7));
+		sub->append(Instruction::STOP);
+		return make_pair(sub, t1);
+	};
+
+	for (bool shared: {false, true})
+	{
+		AssemblyPointer nested = shared ? createSub(nullptr).first : nullptr;
+		Assembly main;
+		AssemblyItems expectationMain;
+		vector<pair<AssemblyPointer, AssemblyItem>> subs;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			subs.emplace_back(createSub(nested));
+			size_t subId = size_t(main.appendSubroutine(subs.back().first).data());
+			AssemblyItem tag = subs.back().second.toSubAssemblyTag(subId).pushTag();
+			main.append(tag);
+			expectationMain += AssemblyItems{AssemblyItem(PushSubSize, subId), tag};
+		}
+
+		main.optimise(true, dev::test::Options::get().evmVersion(), false, 200);
+
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			main.items().begin(), main.items().end(),
+			expectationMain.begin(), expectationMain.end()
+		);
+		for (auto const& [sub, t1]: subs)
+		{
+			AssemblyItems expectationSub{
+				u256(1), t1.tag(), u256(2), Instruction::JUMP
+			};
+			if (nested)
+				expectationSub.insert(expectationSub.begin(), AssemblyItem(PushSubSize, 0));
+			BOOST_CHECK_EQUAL_COLLECTIONS(
+				sub->items().begin(), sub->items().end(),
+				expectationSub.begin(), expectationSub.end()
+			);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cse_across_jumpi)
+{
+	// Knowledge about storage is carried over into the non-jumping branch of a JUMPI,
+	// but not into a block that can also be entered by a jump.
+	for (bool jumpTarget: {false, true})
+	{
+		Assembly main;
+		auto tag = main.newTag();
+		auto target = main.newTag();
+		main.append(u256(0));
+		main.append(Instruction::SLOAD);
+		main.append(Instruction::DUP1);
+		main.append(tag.pushTag());
+		main.append(Instruction::JUMPI);
+		if (jumpTarget)
+			main.append(target);
+		main.append(u256(0));
+		main.append(Instruction::SLOAD);
+		main.append(Instruction::ADD);
+		main.append(u256(1));
+		main.append(Instruction::SSTORE);
+		main.append(Instruction::STOP);
+		main.append(tag);
+		main.append(target.pushTag());
+		main.append(Instruction::JUMP);
+
+		main.optimise(true, dev::test::Options::get().evmVersion(), false, 200);
+
+		BOOST_CHECK_EQUAL(
+			count(main.items().begin(), main.items().end(), AssemblyItem(Instruction::SLOAD)),
+			jumpTarget ? 2 : 1
+		);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(constant_optimiser_repeated)
+{
+	// The constants are optimised concurrently and the results are cached across runs,
+	// which must not change the outcome.
+	auto optimisedItems = [](size_t _runs, unsigned _count)
+	{
+		Assembly assembly;
+		for (unsigned i = 0; i < _count; ++i)
+		{
+			assembly.append((u256(1) << (100 + 3 * i)) - 1);
+			assembly.append(Instruction::POP);
+		}
+		ConstantOptimisationMethod::optimiseConstants(false, _runs, dev::test::Options::get().evmVersion(), assembly);
+		return assembly.items();
+	};
+	for (size_t runs: {1, 200})
+	{
+		ConstantRepresentationCache::clear();
+		AssemblyItems uncached = optimisedItems(runs, 40);
+		// The constants are cheaper to compute than to push.
+		BOOST_CHECK(uncached.size() > 80);
+
+		ConstantRepresentationCache::clear();
+		// Only fill the cache with some of the constants.
+		optimisedItems(runs, 20);
+		AssemblyItems partiallyCached = optimisedItems(runs, 40);
+		AssemblyItems cached = optimisedItems(runs, 40);
+		BOOST_CHECK_EQUAL_COLLECTIONS(uncached.begin(), uncached.end(), partiallyCached.begin(), partiallyCached.end());
+		BOOST_CHECK_EQUAL_COLLECTIONS(uncached.begin(), uncached.end(), cached.begin(), cached.end());
+	}
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
@@ -115,6 +115,140 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(update_sources_reanalyzes_importing_sources)
+{
+	StringMap sources{
+		{"a", "pragma solidity >=0.0; library L { function f() internal pure returns (uint) { return 1; } }"},
+		{"b", "pragma solidity >=0.0; import \"a\"; contract B { function g() public pure returns (uint) { return L.f(); } }"},
+		{"c", "pragma solidity >=0.0; contract C { function h() public pure returns (uint) { return 3; } }"}
+	};
+	string const updatedA = "pragma solidity >=0.0; library L { function f() internal pure returns (uint) { return 2; } }";
+
+	bytes expectation;
+	{
+		CompilerStack c;
+		StringMap updatedSources = sources;
+		updatedSources["a"] = updatedA;
+		c.setSources(updatedSources);
+		c.setEVMVersion(dev::test::Options::get().evmVersion());
+		BOOST_REQUIRE(c.compile());
+		expectation = c.object("b:B").bytecode;
+	}
+
+	CompilerStack c;
+	c.setSources(sources);
+	c.setEVMVersion(dev::test::Options::get().evmVersion());
+	BOOST_REQUIRE(c.compile());
+	bytes original = c.object("b:B").bytecode;
+	SourceUnit const* astA = &c.ast("a");
+	SourceUnit const* astB = &c.ast("b");
+	SourceUnit const* astC = &c.ast("c");
+
+	// Unchanged contents do not invalidate anything.
+	c.updateSources({{"a", sources["a"]}});
+	BOOST_CHECK(c.compilationSuccessful());
+
+	c.updateSources({{"a", updatedA}});
+	BOOST_CHECK(c.state() == CompilerStack::SourcesSet);
+	BOOST_REQUIRE(c.parseAndAnalyze());
+	// All sources after the changed one are parsed again to get the AST IDs of a compilation
+	// from scratch.
+	BOOST_CHECK(&c.ast("a") != astA);
+	BOOST_CHECK(&c.ast("b") != astB);
+	BOOST_CHECK(&c.ast("c") != astC);
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(c.object("b:B").bytecode != original);
+	BOOST_CHECK(c.object("b:B").bytecode == expectation);
+	BOOST_CHECK(!c.object("c:C").bytecode.empty());
+
+	// Sources in front of the changed one are kept.
+	astA = &c.ast("a");
+	astB = &c.ast("b");
+	c.updateSources({{"c", "pragma solidity >=0.0; contract C { function h() public pure returns (uint) { return 4; } }"}});
+	BOOST_REQUIRE(c.parseAndAnalyze());
+	BOOST_CHECK(&c.ast("a") == astA);
+	BOOST_CHECK(&c.ast("b") == astB);
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(c.object("b:B").bytecode == expectation);
+}
+
+BOOST_AUTO_TEST_CASE(update_sources_keeps_warnings_of_unchanged_sources)
+{
+	CompilerStack c;
+	c.setSources({
+		{"a", "pragma solidity >=0.0; contract A { function f() public { uint x; } }"},
+		{"b", "pragma solidity >=0.0; contract B { function g() public pure {} }"}
+	});
+	c.setEVMVersion(dev::test::Options::get().evmVersion());
+	BOOST_REQUIRE(c.parseAndAnalyze());
+	size_t warnings = c.errors().size();
+	BOOST_REQUIRE(warnings > 0);
+
+	c.updateSources({{"b", "pragma solidity >=0.0; contract B { function g() public pure returns (uint) { return 1; } }"}});
+	BOOST_REQUIRE(c.parseAndAnalyze());
+	BOOST_CHECK_EQUAL(c.errors().size(), warnings);
+	for (auto const& error: c.errors())
+		BOOST_CHECK(error->type() == langutil::Error::Type::Warning);
+}
+
+BOOST_AUTO_TEST_CASE(update_sources_after_error)
+{
+	CompilerStack c;
+	c.setSources({
+		{"a", "pragma solidity >=0.0; contract A { function f() public pure returns (uint) { return 1; } }"},
+		{"b", "pragma solidity >=0.0; import \"a\"; contract B is A {}"}
+	});
+	c.setEVMVersion(dev::test::Options::get().evmVersion());
+	BOOST_REQUIRE(c.parseAndAnalyze());
+
+	c.updateSources({{"a", "pragma solidity >=0.0; contract A { function f() public pure returns (uint) { return true; } }"}});
+	BOOST_CHECK(!c.parseAndAnalyze());
+
+	// Since the previous analysis failed, all sources are analyzed again.
+	c.updateSources({{"a", "pragma solidity >=0.0; contract A { function f() public pure returns (uint) { return 2; } }"}});
+	BOOST_REQUIRE(c.parseAndAnalyze());
+	BOOST_CHECK(langutil::Error::containsOnlyWarnings(c.errors()));
+	BOOST_CHECK(c.compile());
+}
+
+BOOST_AUTO_TEST_CASE(update_sources_does_not_accumulate_warnings)
+{
+	auto sourceA = [](size_t _i) {
+		return "pragma solidity >=0.0; contract A { function f() public { uint x" + to_string(_i) + "; } }";
+	};
+	StringMap sources{{"a", sourceA(0)}};
+	for (size_t i = 0; i < 4; ++i)
+		sources["b" + to_string(i)] = "pragma solidity >=0.0; contract B" + to_string(i) + " {}";
+	sources["smt"] =
+		"pragma solidity >=0.0; pragma experimental SMTChecker;"
+		"contract S { function g(uint y) public pure { assert(y > 0); } }";
+
+	CompilerStack c;
+	c.setSources(sources);
+	c.setEVMVersion(dev::test::Options::get().evmVersion());
+	BOOST_REQUIRE(c.parseAndAnalyze());
+	size_t warnings = c.errors().size();
+	size_t queries = c.unhandledSMTLib2Queries().size();
+	BOOST_REQUIRE(warnings > 0);
+
+	// More updates than warnings are allowed, in between some of them analyze all sources.
+	for (size_t i = 1; i <= 300; ++i)
+	{
+		c.updateSources({
+			{"a", sourceA(i)},
+			{"smt", sources["smt"] + (i % 2 ? " " : "")}
+		});
+		BOOST_REQUIRE(c.parseAndAnalyze());
+		BOOST_REQUIRE_EQUAL(c.errors().size(), warnings);
+		BOOST_REQUIRE_EQUAL(c.unhandledSMTLib2Queries().size(), queries);
+	}
+	bool warningForA = false;
+	for (auto const& error: c.errors())
+		if (auto location = boost::get_error_info<langutil::errinfo_sourceLocation>(*error))
+			warningForA = warningForA || (location->source && location->source->name() == "a");
+	BOOST_CHECK(warningForA);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -22,6 +22,10 @@
 #include <test/Metadata.h>
 #include <test/Options.h>
 
+#include <libsolidity/interface/CompilerStack.h>
+#include <libyul/YulString.h>
+#include <libdevcore/Profiler.h>
+
 using namespace std;
 
 namespace dev
@@ -53,6 +57,68 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(reused_optimised_abi_coder_routines)
+{
+	// A and B use the same struct of the library L and request the same routines.
+	string const library = "library L { struct S { uint a; bytes b; } }";
+	auto source = [](string const& _name) {
+		return
+			"pragma experimental ABIEncoderV2;\n"
+			"import \"l\";\n"
+			"contract " + _name + " {\n"
+			"	function f(L.S[] memory _s, string memory _t) public pure returns (L.S[] memory, string memory) { return (_s, _t); }\n"
+			"}\n";
+	};
+	// The routines of C and D only differ in the IDs of their structs.
+	auto sourceWithStruct = [](string const& _name) {
+		return
+			"pragma experimental ABIEncoderV2;\n"
+			"contract " + _name + " {\n"
+			"	struct S { uint a; bytes b; }\n"
+			"	function f(S[] memory _s, string memory _t) public pure returns (S[] memory, string memory) { return (_s, _t); }\n"
+			"}\n";
+	};
+	// @returns the stack and how often the Yul optimiser ran during its compilation.
+	auto compile = [](StringMap const& _sources) {
+		// Resetting the YulString repository also clears the cache of optimised routines.
+		yul::YulStringRepository::reset();
+		Profiler::instance().reset();
+		Profiler::instance().setEnabled(true);
+		auto stack = make_unique<CompilerStack>();
+		stack->setSources(_sources);
+		stack->setEVMVersion(dev::test::Options::get().evmVersion());
+		stack->setOptimiserSettings(OptimiserSettings::full());
+		BOOST_REQUIRE(stack->compile());
+		Profiler::instance().setEnabled(false);
+		uint64_t optimiserRuns = Profiler::instance().report()["phases"]["OptimiserSuite"]["calls"].asUInt64();
+		Profiler::instance().reset();
+		return make_pair(move(stack), optimiserRuns);
+	};
+
+	auto [uncached, uncachedRuns] = compile({{"b", source("B")}, {"l", library}});
+	BOOST_CHECK(uncachedRuns > 0);
+	bytes creation = uncached->object("b:B").bytecode;
+	bytes runtime = uncached->runtimeObject("b:B").bytecode;
+	uncached.reset();
+
+	// B is compiled after A and re-uses all its routines.
+	auto [cached, cachedRuns] = compile({{"a", source("A")}, {"b", source("B")}, {"l", library}});
+	BOOST_CHECK_EQUAL(cachedRuns, uncachedRuns);
+	BOOST_CHECK(cached->object("b:B").bytecode == creation);
+	BOOST_CHECK(cached->runtimeObject("b:B").bytecode == runtime);
+	cached.reset();
+
+	tie(uncached, uncachedRuns) = compile({{"d", sourceWithStruct("D")}});
+	creation = uncached->object("d:D").bytecode;
+	runtime = uncached->runtimeObject("d:D").bytecode;
+	uncached.reset();
+
+	tie(cached, cachedRuns) = compile({{"c", sourceWithStruct("C")}, {"d", sourceWithStruct("D")}});
+	BOOST_CHECK_EQUAL(cachedRuns, uncachedRuns);
+	BOOST_CHECK(cached->object("d:D").bytecode == creation);
+	BOOST_CHECK(cached->runtimeObject("d:D").bytecode == runtime);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -24,6 +24,7 @@
 #include <memory>
 #include <liblangutil/Scanner.h>
 #include <libsolidity/parsing/Parser.h>
+#include <libsolidity/ast/ASTArena.h>
 #include <liblangutil/ErrorReporter.h>
 #include <test/Options.h>
 #include <test/libsolidity/ErrorCheck.h>
@@ -684,6 +685,44 @@ BOOST_AUTO_TEST_CASE(inline_asm_end_location)
 	BOOST_CHECK_MESSAGE(visitor.visited, "No inline asm block found?!");
 }
 
+BOOST_AUTO_TEST_CASE(arena_allocation)
+{
+	char const* text = R"(
+		contract C {
+			uint[] x;
+			function f(uint a) public returns (uint b) {
+				for (uint i = 0; i < a; i++)
+					x.push(i * a);
+				b = x.length;
+			}
+		}
+	)";
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	auto arena = make_shared<ASTArena>();
+	ASTPointer<SourceUnit> sourceUnit = Parser(
+		errorReporter,
+		dev::test::Options::get().evmVersion(),
+		false,
+		arena
+	).parse(std::make_shared<Scanner>(CharStream(text, "")));
+	BOOST_REQUIRE(sourceUnit);
+	BOOST_CHECK(errors.empty());
+	BOOST_CHECK_GT(arena->allocatedBytes(), sizeof(SourceUnit));
+
+	// The nodes keep the arena alive.
+	weak_ptr<ASTArena> weakArena = arena;
+	arena.reset();
+	BOOST_CHECK(!weakArena.expired());
+	auto contract = dynamic_pointer_cast<ContractDefinition>(sourceUnit->nodes().back());
+	BOOST_REQUIRE(contract);
+	BOOST_CHECK_EQUAL(contract->name(), "C");
+	BOOST_CHECK_EQUAL(contract->definedFunctions().size(), 1);
+	sourceUnit.reset();
+	contract.reset();
+	BOOST_CHECK(weakArena.expired());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -20,10 +20,13 @@
  */
 
 #include <string>
+#include <fstream>
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/Profiler.h>
 #include <test/Metadata.h>
 
 using namespace std;
@@ -1071,6 +1074,90 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_details_stack_shuffle)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "stackShuffle": true } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint a, uint b) public pure returns (uint) { return b; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& optimizer = metadata["settings"]["optimizer"];
+	BOOST_CHECK(!optimizer.isMember("enabled"));
+	BOOST_CHECK(optimizer["details"]["stackShuffle"].asBool() == true);
+	BOOST_CHECK(optimizer["details"]["cse"].asBool() == true);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_details_yul_steps)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yul": true,
+				"yulDetails": { "optimizerSteps": "dhfoDgvufnTUtnIf [xarrscL gvif] jmu" }
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "pragma experimental ABIEncoderV2; contract A { function f(uint[] memory a) public pure returns (uint) { return a[0]; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK_EQUAL(yulDetails["optimizerSteps"].asString(), "dhfoDgvufnTUtnIf [xarrscL gvif] jmu");
+
+	Json::Value invalidInput;
+	BOOST_REQUIRE(jsonParseStrict(input, invalidInput));
+	invalidInput["settings"]["optimizer"]["details"]["yulDetails"]["optimizerSteps"] = "xarrscL]";
+	result = compile(jsonCompactPrint(invalidInput));
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"Invalid optimizer step sequence in \"settings.optimizer.details.yulDetails.optimizerSteps\": "
+		"Unbalanced brackets in optimiser sequence."
+	));
+	invalidInput["settings"]["optimizer"]["details"]["yulDetails"]["optimizerSteps"] = "xarrscLz";
+	result = compile(jsonCompactPrint(invalidInput));
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"Invalid optimizer step sequence in \"settings.optimizer.details.yulDetails.optimizerSteps\": "
+		"'z' is not a valid optimiser step abbreviation."
+	));
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1368,6 +1455,348 @@ BOOST_AUTO_TEST_CASE(standard_output_selection_wildcard_multiple_sources)
 	BOOST_REQUIRE(result["sources"]["B"].isObject());
 }
 
+BOOST_AUTO_TEST_CASE(profile_not_boolean)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"profile": "yes"
+		},
+		"sources": {
+			"empty": {
+				"content": ""
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.profile\" must be a Boolean."));
+}
+
+BOOST_AUTO_TEST_CASE(profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A": {
+				"content": "pragma solidity >=0.0; contract C { function f() public pure returns (uint) { return 7; } }"
+			}
+		},
+		"settings": {
+			"profile": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "C": ["evm.bytecode.object"] }
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result["profile"].isObject());
+	Json::Value const& phases = result["profile"]["phases"];
+	BOOST_REQUIRE(phases.isObject());
+	for (string phase: {"Parser", "NameAndTypeResolver", "TypeChecker", "ContractCompiler", "Assembly::optimise/PeepholeOptimiser"})
+	{
+		BOOST_REQUIRE_MESSAGE(phases[phase].isObject(), "Missing phase " + phase);
+		BOOST_CHECK(phases[phase]["calls"].asUInt64() > 0);
+		BOOST_CHECK(phases[phase]["wallTimeMs"].isDouble());
+		BOOST_CHECK(phases[phase]["cpuTimeMs"].isDouble());
+		BOOST_CHECK(phases[phase]["minorPageFaults"].isUInt64());
+		BOOST_CHECK(phases[phase]["peakRSSGrowthKb"].isUInt64());
+	}
+
+	// Profiling is switched off again after the compilation.
+	BOOST_CHECK(!dev::Profiler::instance().enabled());
+	result = compile(R"({"language": "Solidity", "sources": {"A": {"content": "contract C {}"}}})");
+	BOOST_CHECK(!result.isMember("profile"));
+}
+
+BOOST_AUTO_TEST_CASE(cache_directory)
+{
+	string const sourceA = "pragma solidity >=0.0; contract A { function f() public pure returns (uint) { return 1; } }";
+	string const sourceB = "pragma solidity >=0.0; import \"A\"; contract B is A { function g() public { new A(); } }";
+	auto makeInput = [&](string const& _sourceB) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["A"]["content"] = sourceA;
+		input["sources"]["B"]["content"] = _sourceB;
+		input["settings"]["optimizer"]["enabled"] = true;
+		for (string output: {"evm.bytecode", "evm.deployedBytecode", "evm.gasEstimates", "evm.assembly", "metadata"})
+			input["settings"]["outputSelection"]["*"]["*"].append(output);
+		return input;
+	};
+	Json::Value const input = makeInput(sourceB);
+
+	boost::filesystem::path cacheDir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	auto cacheEntries = [&]() {
+		vector<boost::filesystem::path> entries;
+		for (auto const& entry: boost::filesystem::directory_iterator(cacheDir))
+			entries.push_back(entry.path());
+		return entries;
+	};
+
+	Json::Value expectation = solidity::StandardCompiler{}.compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(expectation));
+
+	// Cold and warm runs both produce the same output as a compilation without cache.
+	for (size_t run = 0; run < 2; ++run)
+	{
+		solidity::StandardCompiler compiler;
+		compiler.setCacheDirectory(cacheDir);
+		BOOST_CHECK(compiler.compile(input) == expectation);
+		BOOST_CHECK_EQUAL(cacheEntries().size(), 2);
+	}
+
+	// Cached outputs are used instead of compiling the contracts again.
+	for (auto const& entry: cacheEntries())
+	{
+		Json::Value cached;
+		BOOST_REQUIRE(jsonParseFile(entry.string(), cached));
+		cached["marker"] = entry.filename().string();
+		ofstream(entry.string()) << jsonCompactPrint(cached);
+	}
+	{
+		solidity::StandardCompiler compiler;
+		compiler.setCacheDirectory(cacheDir);
+		Json::Value result = compiler.compile(input);
+		BOOST_CHECK(result["contracts"]["A"]["A"].isMember("marker"));
+		BOOST_CHECK(result["contracts"]["B"]["B"].isMember("marker"));
+	}
+
+	// Changing B does not affect the output of A.
+	{
+		solidity::StandardCompiler compiler;
+		compiler.setCacheDirectory(cacheDir);
+		Json::Value modifiedInput = makeInput(sourceB + " contract C {}");
+		Json::Value result = compiler.compile(modifiedInput);
+		BOOST_CHECK(containsAtMostWarnings(result));
+		BOOST_CHECK(result["contracts"]["A"]["A"].isMember("marker"));
+		BOOST_CHECK(!result["contracts"]["B"]["B"].isMember("marker"));
+		BOOST_CHECK(!result["contracts"]["B"]["C"].isMember("marker"));
+		BOOST_CHECK_EQUAL(cacheEntries().size(), 4);
+	}
+
+	// A source in front of A changes the AST IDs in A, which the generated code can depend on.
+	{
+		Json::Value modifiedInput = input;
+		modifiedInput["sources"]["0"]["content"] = "pragma solidity >=0.0; contract Z {}";
+		solidity::StandardCompiler compiler;
+		compiler.setCacheDirectory(cacheDir);
+		Json::Value result = compiler.compile(modifiedInput);
+		BOOST_CHECK(containsAtMostWarnings(result));
+		BOOST_CHECK(!result["contracts"]["A"]["A"].isMember("marker"));
+		BOOST_CHECK(!result["contracts"]["B"]["B"].isMember("marker"));
+	}
+
+	// If another contract fails to compile, the cached outputs are not used either.
+	{
+		Json::Value modifiedInput = input;
+		modifiedInput["sources"]["D"]["content"] =
+			"pragma solidity >=0.0; contract D { function f("
+			"uint a1, uint a2, uint a3, uint a4, uint a5, uint a6, uint a7, uint a8, uint a9, "
+			"uint a10, uint a11, uint a12, uint a13, uint a14, uint a15, uint a16, uint a17"
+			") public pure returns (uint) { return a1 + a17; } }";
+		solidity::StandardCompiler compiler;
+		compiler.setCacheDirectory(cacheDir);
+		Json::Value result = compiler.compile(modifiedInput);
+		BOOST_CHECK(!containsAtMostWarnings(result));
+		BOOST_CHECK(!result["contracts"]["A"]["A"].isMember("marker"));
+		BOOST_CHECK(!result["contracts"]["A"]["A"].isMember("evm"));
+	}
+
+	boost::filesystem::remove_all(cacheDir);
+}
+
+BOOST_AUTO_TEST_CASE(kept_compiler_stack)
+{
+	auto makeInput = [](string const& _sourceB) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["A"]["content"] = "contract A { function f() public pure returns (uint) { return 1; } }";
+		input["sources"]["B"]["content"] = _sourceB;
+		input["settings"]["outputSelection"]["*"][""][0] = "ast";
+		input["settings"]["outputSelection"]["*"]["*"][0] = "evm.bytecode.object";
+		return input;
+	};
+	auto astID = [](Json::Value const& _result, string const& _source) {
+		return _result["sources"][_source]["ast"]["id"].asInt();
+	};
+	Json::Value input = makeInput("contract B { function g() public pure returns (uint) { return 2; } }");
+	Json::Value modifiedInput = makeInput("contract B { function g() public pure returns (uint) { return 3; } }");
+	// Only one compiler stack can exist at a time, so the output without a kept compiler
+	// stack has to be produced first.
+	Json::Value expectation = solidity::StandardCompiler{}.compile(modifiedInput);
+	BOOST_CHECK(containsAtMostWarnings(expectation));
+
+	solidity::StandardCompiler compiler;
+	compiler.keepCompilerStack();
+	Json::Value first = compiler.compile(input);
+	BOOST_CHECK(containsAtMostWarnings(first));
+	Json::Value second = compiler.compile(modifiedInput);
+	BOOST_CHECK(containsAtMostWarnings(second));
+
+	// The output is the same as without a kept compiler stack, including the AST IDs.
+	BOOST_CHECK_EQUAL(astID(first, "A"), astID(second, "A"));
+	BOOST_CHECK(second["sources"] == expectation["sources"]);
+	BOOST_CHECK(second["contracts"] == expectation["contracts"]);
+	BOOST_CHECK(second["errors"] == expectation["errors"]);
+
+	// Unchanged sources do not cause any re-analysis.
+	Json::Value third = compiler.compile(modifiedInput);
+	BOOST_CHECK_EQUAL(astID(third, "B"), astID(second, "B"));
+	BOOST_CHECK(third["contracts"] == expectation["contracts"]);
+
+	// Different settings need a new compiler stack.
+	modifiedInput["settings"]["evmVersion"] = "byzantium";
+	Json::Value fourth = compiler.compile(modifiedInput);
+	BOOST_CHECK(containsAtMostWarnings(fourth));
+	BOOST_CHECK_EQUAL(astID(fourth, "B"), astID(first, "B"));
+}
+
+BOOST_AUTO_TEST_CASE(kept_compiler_stack_ast_ids)
+{
+	// The names of the ABI coder routines contain the IDs of struct types, so the bytecode
+	// depends on the AST IDs.
+	string const sourceB = R"(
+		pragma experimental ABIEncoderV2;
+		import "a.sol";
+		contract B { function f(L.S memory _s) public pure returns (L.S memory) { return _s; } }
+	)";
+	string const sourceC = "contract C { uint x; function g() public payable returns (uint) { return msg.value + x; } }";
+	auto makeInput = [](string const& _sourceA, string const& _sourceB, string const& _sourceC) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["a.sol"]["content"] = _sourceA;
+		input["sources"]["b.sol"]["content"] = _sourceB;
+		input["sources"]["c.sol"]["content"] = _sourceC;
+		input["settings"]["outputSelection"]["*"][""][0] = "ast";
+		input["settings"]["outputSelection"]["*"]["*"][0] = "evm.bytecode.object";
+		input["settings"]["outputSelection"]["*"]["*"][1] = "evm.deployedBytecode.object";
+		input["settings"]["outputSelection"]["*"]["*"][2] = "metadata";
+		return input;
+	};
+	vector<Json::Value> inputs{
+		makeInput("library L { struct S { uint a; uint[] b; } }", sourceB, sourceC),
+		// Changes the IDs of all sources.
+		makeInput("library L { struct S { uint a; uint[] b; } } contract A { uint x; uint y; }", sourceB, sourceC),
+		// Keeps the first source and changes the IDs of the last one.
+		makeInput(
+			"library L { struct S { uint a; uint[] b; } } contract A { uint x; uint y; }",
+			sourceB + " contract D { uint z; }",
+			sourceC
+		),
+		// Only the last source is parsed again.
+		makeInput(
+			"library L { struct S { uint a; uint[] b; } } contract A { uint x; uint y; }",
+			sourceB + " contract D { uint z; }",
+			sourceC + " contract E {}"
+		)
+	};
+	// Only one compiler stack can exist at a time, so the outputs without a kept compiler
+	// stack have to be produced first.
+	vector<Json::Value> expectations;
+	for (Json::Value const& input: inputs)
+	{
+		expectations.emplace_back(solidity::StandardCompiler{}.compile(input));
+		BOOST_CHECK(containsAtMostWarnings(expectations.back()));
+	}
+
+	solidity::StandardCompiler compiler;
+	compiler.keepCompilerStack();
+	for (size_t i = 0; i < inputs.size(); ++i)
+	{
+		Json::Value result = compiler.compile(inputs[i]);
+		BOOST_CHECK(result["sources"] == expectations[i]["sources"]);
+		BOOST_CHECK(result["contracts"] == expectations[i]["contracts"]);
+		BOOST_CHECK(result["errors"] == expectations[i]["errors"]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(kept_compiler_stack_dropped_source)
+{
+	string const sourceC = "contract C { function h() public pure returns (uint) { return 3; } }";
+	auto makeInput = [&](bool _withC) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["A"]["content"] = "contract A { function f() public pure returns (uint) { return 1; } }";
+		input["sources"]["B"]["content"] = "contract B { function g() public pure returns (uint) { return 2; } }";
+		if (_withC)
+			input["sources"]["C"]["content"] = sourceC;
+		input["settings"]["outputSelection"]["*"][""][0] = "ast";
+		input["settings"]["outputSelection"]["*"]["*"][0] = "evm.bytecode.object";
+		return input;
+	};
+	// C can also be read through the callback, so it would be compiled again if it was
+	// mistaken for a source that is only reached through imports.
+	solidity::StandardCompiler compiler([&](string const& _path) {
+		if (_path == "C")
+			return ReadCallback::Result{true, sourceC};
+		return ReadCallback::Result{false, "File not found."};
+	});
+	compiler.keepCompilerStack();
+
+	Json::Value first = compiler.compile(makeInput(false));
+	BOOST_CHECK(containsAtMostWarnings(first));
+	Json::Value second = compiler.compile(makeInput(true));
+	BOOST_CHECK(containsAtMostWarnings(second));
+	BOOST_CHECK(second["contracts"].isMember("C"));
+	Json::Value third = compiler.compile(makeInput(false));
+	BOOST_CHECK(containsAtMostWarnings(third));
+
+	BOOST_CHECK(!third["sources"].isMember("C"));
+	BOOST_CHECK(!third["contracts"].isMember("C"));
+	BOOST_CHECK(third == first);
+}
+
+BOOST_AUTO_TEST_CASE(kept_compiler_stack_changed_import)
+{
+	Json::Value input;
+	input["language"] = "Solidity";
+	input["sources"]["a.sol"]["content"] = R"(
+		pragma experimental ABIEncoderV2;
+		import "l.sol";
+		contract A { function f(L.S memory _s) public pure returns (L.S memory) { return _s; } }
+	)";
+	input["sources"]["z.sol"]["content"] = "contract Z { function g() public pure returns (uint) { return 1; } }";
+	input["settings"]["outputSelection"]["*"][""][0] = "ast";
+	input["settings"]["outputSelection"]["*"]["*"][0] = "evm.bytecode.object";
+	vector<string> const librarySources{
+		"library L { struct S { uint a; uint[] b; } }",
+		"library L { struct S { uint a; uint[] b; } } contract K { uint x; }"
+	};
+	string librarySource;
+	auto readFile = [&](string const& _path) {
+		if (_path == "l.sol")
+			return ReadCallback::Result{true, librarySource};
+		return ReadCallback::Result{false, "File not found."};
+	};
+
+	// Only one compiler stack can exist at a time, so the outputs without a kept compiler
+	// stack have to be produced first.
+	vector<Json::Value> expectations;
+	for (string const& source: librarySources)
+	{
+		librarySource = source;
+		expectations.emplace_back(solidity::StandardCompiler{readFile}.compile(input));
+		BOOST_CHECK(containsAtMostWarnings(expectations.back()));
+	}
+
+	// The imported source changes the IDs of the sources parsed after it, so the kept
+	// compiler stack must not be updated with it as an input.
+	solidity::StandardCompiler compiler{readFile};
+	compiler.keepCompilerStack();
+	for (size_t i = 0; i < librarySources.size(); ++i)
+	{
+		librarySource = librarySources[i];
+		Json::Value result = compiler.compile(input);
+		BOOST_CHECK(result["sources"] == expectations[i]["sources"]);
+		BOOST_CHECK(result["contracts"] == expectations[i]["contracts"]);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -17,9 +17,9 @@ contract C {
 // optimize-yul: true
 // ----
 // creation:
-//   codeDepositCost: 608400
+//   codeDepositCost: 608600
 //   executionCost: 645
-//   totalCost: 609045
+//   totalCost: 609245
 // external:
 //   a(): 429
 //   b(uint256): 884
@@ -21,13 +21,20 @@
 
 #include <test/libyul/Common.h>
 
+#include <libyul/optimiser/CallSiteProfile.h>
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/InlinableExpressionFunctionFinder.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/FunctionHoister.h>
 #include <libyul/optimiser/FunctionGrouper.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AsmPrinter.h>
 
+#include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
+
 #include <boost/test/unit_test.hpp>
 
 #include <boost/range/adaptors.hpp>
@@ -53,6 +60,18 @@ string inlinableFunctions(string const& _source)
 	return boost::algorithm::join(functionNames, ",");
 }
 
+/// @returns the number of calls to @a _function that remain after running the full inliner.
+size_t callsAfterFullInlining(string const& _source, string const& _function, CallSiteCounts const* _counts)
+{
+	Block ast = disambiguate(_source, false);
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVM(langutil::EVMVersion{});
+	NameDispenser dispenser{dialect, ast};
+	set<YulString> reservedIdentifiers;
+	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, _counts};
+	FullInliner::run(context, ast);
+	return ReferencesCounter::countReferences(ast)[YulString{_function}];
+}
+
 }
 
 
@@ -106,4 +125,70 @@ BOOST_AUTO_TEST_CASE(negative)
 }
 
 
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(YulFullInliner)
+
+BOOST_AUTO_TEST_CASE(call_site_profile)
+{
+	string source = R"({
+		{
+			let a := calldataload(0)
+			let x := f(a)
+			let y := f(x)
+			sstore(x, y)
+		}
+		function f(v) -> r {
+			let t := mul(v, v)
+			t := mul(t, v)
+			r := add(add(t, v), add(t, 7))
+		}
+	})";
+	int hotCall = int(source.find("f(a)"));
+	int coldCall = int(source.find("f(x)"));
+
+	// Too big to be inlined without a profile.
+	BOOST_CHECK_EQUAL(callsAfterFullInlining(source, "f", nullptr), 2);
+
+	// The test sources are parsed without a source name.
+	CallSiteCounts counts{{{"", hotCall, hotCall + 4}, 100}};
+	BOOST_CHECK_EQUAL(callsAfterFullInlining(source, "f", &counts), 1);
+	counts[{"", coldCall, coldCall + 4}] = 100;
+	BOOST_CHECK_EQUAL(callsAfterFullInlining(source, "f", &counts), 0);
+	counts = {{{"", hotCall, hotCall + 4}, 1}, {{"", coldCall, coldCall + 4}, 1000}};
+	BOOST_CHECK_EQUAL(callsAfterFullInlining(source, "f", &counts), 1);
+
+	// Counts of calls at the same offsets in a different source do not apply.
+	counts = {{{"other", hotCall, hotCall + 4}, 100}, {{"other", coldCall, coldCall + 4}, 100}};
+	BOOST_CHECK_EQUAL(callsAfterFullInlining(source, "f", &counts), 2);
+}
+
+BOOST_AUTO_TEST_CASE(call_site_profile_json)
+{
+	string const source = "{ function f() {} f() f() }";
+	CallSiteProfile profile;
+	profile.sourceHashes["a.yul"] = dev::keccak256(source);
+	profile.sourceHashes["b.yul"] = dev::keccak256("{}");
+	profile.counts = {{{"a.yul", 18, 21}, 1}, {{"a.yul", 22, 25}, 7}};
+
+	std::optional<CallSiteProfile> parsed = callSiteProfileFromJson(dev::jsonCompactPrint(callSiteProfileToJson(profile)));
+	BOOST_REQUIRE(parsed);
+	BOOST_CHECK(parsed->sourceHashes == profile.sourceHashes);
+	BOOST_CHECK(parsed->counts == profile.counts);
+
+	std::optional<CallSiteCounts> counts = callSiteCountsForSource(*parsed, "a.yul", source);
+	BOOST_REQUIRE(counts);
+	BOOST_CHECK(*counts == profile.counts);
+	counts = callSiteCountsForSource(*parsed, "b.yul", "{}");
+	BOOST_REQUIRE(counts);
+	BOOST_CHECK(counts->empty());
+
+	// The profile does not apply to changed or unknown sources.
+	BOOST_CHECK(!callSiteCountsForSource(*parsed, "a.yul", source + " "));
+	BOOST_CHECK(!callSiteCountsForSource(*parsed, "c.yul", source));
+
+	BOOST_CHECK(!callSiteProfileFromJson("{\"callSites\": []}"));
+	BOOST_CHECK(!callSiteProfileFromJson("{\"sources\": {\"a.yul\": {\"keccak256\": \"0x12\", \"callSites\": []}}}"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
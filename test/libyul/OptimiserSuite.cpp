@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for custom sequences of optimiser steps.
+ */
+
+#include <test/Options.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/Exceptions.h>
+#include <libyul/optimiser/Suite.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace dev::solidity;
+
+namespace yul
+{
+namespace test
+{
+
+namespace
+{
+
+/// Optimises and assembles @a _source using the given step sequence.
+void optimiseWithSequence(string const& _source, string const& _sequence)
+{
+	OptimiserSettings settings = OptimiserSettings::full();
+	settings.yulOptimiserSteps = _sequence;
+	AssemblyStack stack(dev::test::Options::get().evmVersion(), AssemblyStack::Language::StrictAssembly, settings);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	stack.optimize();
+	BOOST_CHECK(stack.assemble(AssemblyStack::Machine::EVM).bytecode);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimiserSuite)
+
+BOOST_AUTO_TEST_CASE(custom_sequence_prerequisites)
+{
+	string source = R"({
+		let s := 0
+		for { let i := 0 } lt(i, calldataload(0)) { i := add(i, 1) } {
+			s := f(s, i)
+		}
+		sstore(0, s)
+		function f(a, b) -> r {
+			for { let j := 0 } lt(j, b) { j := add(j, 1) } { r := add(r, a) }
+		}
+	})";
+	// Neither of these sequences establishes the prerequisites of its steps itself.
+	for (string sequence: {"c", "i", "xarL", "[xa c i u]", "", OptimiserSettings::DefaultYulOptimiserSteps})
+		BOOST_CHECK_NO_THROW(optimiseWithSequence(source, sequence));
+}
+
+BOOST_AUTO_TEST_CASE(invalid_sequence)
+{
+	BOOST_CHECK_NO_THROW(OptimiserSuite::validateSequence(" xa [c [i] u] "));
+	BOOST_CHECK_THROW(OptimiserSuite::validateSequence("xa[c"), OptimizerException);
+	BOOST_CHECK_THROW(OptimiserSuite::validateSequence("xa]c["), OptimizerException);
+	BOOST_CHECK_THROW(OptimiserSuite::validateSequence("xaz"), OptimizerException);
+	// The variable name cleaner cannot be part of a sequence.
+	BOOST_CHECK_THROW(OptimiserSuite::validateSequence("xal"), OptimizerException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
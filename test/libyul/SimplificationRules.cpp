@@ -0,0 +1,164 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the lookup of simplification rules.
+ */
+
+#include <test/Options.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AsmData.h>
+
+#include <libevmasm/RuleList.h>
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace langutil;
+
+namespace yul
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(YulSimplificationRules)
+
+BOOST_AUTO_TEST_CASE(rule_index)
+{
+	// The rules selected through the index of argument shapes have to yield the same first
+	// match as trying all rules with the same root instruction in order.
+	dev::eth::MatchGroups<Expression> matchGroups;
+	Pattern A(PatternKind::Constant);
+	Pattern B(PatternKind::Constant);
+	Pattern C(PatternKind::Constant);
+	Pattern W;
+	Pattern X;
+	Pattern Y;
+	Pattern Z;
+	A.setMatchGroup(1, matchGroups);
+	B.setMatchGroup(2, matchGroups);
+	C.setMatchGroup(3, matchGroups);
+	W.setMatchGroup(4, matchGroups);
+	X.setMatchGroup(5, matchGroups);
+	Y.setMatchGroup(6, matchGroups);
+	Z.setMatchGroup(7, matchGroups);
+	vector<SimplificationRule<Pattern>> ruleList = simplificationRuleList(A, B, C, W, X, Y, Z);
+
+	auto describe = [](SimplificationRule<Pattern> const* _rule) -> string {
+		if (!_rule)
+			return "no match";
+		Expression replacement = _rule->action().toExpression(SourceLocation());
+		return boost::apply_visitor(AsmPrinter{}, replacement);
+	};
+
+	// "v" is assigned twice and thus has no known value - an argument no pattern asks for.
+	auto ast = parse(R"({
+		let x := calldataload(0)
+		let y := calldataload(32)
+		let n := not(x)
+		let z := iszero(x)
+		let s := add(x, 3)
+		let m := and(x, 0xff)
+		let h := shl(8, y)
+		let a := address()
+		let k := 7
+		let v := 0
+		v := calldataload(64)
+	})", false).first;
+	SSAValueTracker tracker;
+	tracker(*ast);
+	map<YulString, Expression const*> const& ssaValues = tracker.values();
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVM(dev::test::Options::get().evmVersion());
+
+	auto literal = [](string const& _value) -> Expression {
+		return Literal{{}, LiteralKind::Number, YulString{_value}, {}};
+	};
+	auto call = [](dev::eth::Instruction _instruction, vector<Expression> _arguments) -> Expression {
+		return FunctionCall{
+			{},
+			Identifier{{}, YulString{boost::algorithm::to_lower_copy(instructionInfo(_instruction).name)}},
+			std::move(_arguments)
+		};
+	};
+	vector<Expression> arguments{
+		literal("0"),
+		literal("1"),
+		literal("0xff"),
+		literal("0x" + string(64, 'f'))
+	};
+	for (string name: {"x", "y", "n", "z", "s", "m", "h", "a", "k", "v"})
+		arguments.emplace_back(Identifier{{}, YulString{name}});
+	arguments.emplace_back(call(dev::eth::Instruction::NOT, {Identifier{{}, YulString{"x"}}}));
+	arguments.emplace_back(call(dev::eth::Instruction::SUB, {literal("0"), call(dev::eth::Instruction::AND, {Identifier{{}, YulString{"y"}}, literal("1")})}));
+	arguments.emplace_back(call(dev::eth::Instruction::ADDRESS, {}));
+
+	set<dev::eth::Instruction> instructions;
+	for (auto const& rule: ruleList)
+		instructions.insert(rule.pattern.instruction());
+	instructions.insert(dev::eth::Instruction::ADDRESS);
+	instructions.insert(dev::eth::Instruction::CALLDATALOAD);
+
+	size_t matches = 0;
+	for (dev::eth::Instruction instruction: instructions)
+	{
+		size_t arity = size_t(instructionInfo(instruction).args);
+		vector<size_t> choice(arity, 0);
+		while (true)
+		{
+			vector<Expression> callArguments;
+			for (size_t index: choice)
+				callArguments.push_back(arguments[index]);
+			Expression expression = call(instruction, std::move(callArguments));
+
+			string indexed = describe(SimplificationRules::findFirstMatch(expression, dialect, ssaValues));
+
+			SimplificationRule<Pattern> const* linear = nullptr;
+			for (auto const& rule: ruleList)
+				if (rule.pattern.instruction() == instruction)
+				{
+					matchGroups.clear();
+					if (rule.pattern.matches(expression, dialect, ssaValues) && (!rule.feasible || rule.feasible()))
+					{
+						linear = &rule;
+						break;
+					}
+				}
+			BOOST_CHECK_EQUAL(indexed, describe(linear));
+			if (linear)
+				matches++;
+
+			size_t i = 0;
+			for (; i < arity && ++choice[i] == arguments.size(); ++i)
+				choice[i] = 0;
+			if (i == arity)
+				break;
+		}
+	}
+	BOOST_CHECK(matches > 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace yul
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringRepositoryTest)
+
+BOOST_AUTO_TEST_CASE(empty_string)
+{
+	BOOST_CHECK(YulString{}.empty());
+	BOOST_CHECK(YulString{""}.empty());
+	BOOST_CHECK(YulString{} == YulString{""});
+	BOOST_CHECK_EQUAL(YulString{}.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(identity)
+{
+	YulString a{"abc"};
+	YulString b{string("ab") + "c"};
+	YulString c{"abd"};
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(a != c);
+	BOOST_CHECK_EQUAL(a.str(), "abc");
+	BOOST_CHECK_EQUAL(c.str(), "abd");
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("abc"));
+}
+
+BOOST_AUTO_TEST_CASE(many_strings)
+{
+	// Spans more than one storage chunk.
+	vector<YulString> strings;
+	for (size_t i = 0; i < 10000; ++i)
+		strings.emplace_back("many_strings_" + to_string(i));
+	for (size_t i = 0; i < strings.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(strings[i].str(), "many_strings_" + to_string(i));
+		BOOST_CHECK(strings[i] == YulString{"many_strings_" + to_string(i)});
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const threadCount = 4;
+	size_t const stringCount = 2000;
+	vector<vector<YulString>> results(threadCount);
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]() {
+			// All threads intern the same strings, but in different orders.
+			for (size_t i = 0; i < stringCount; ++i)
+			{
+				size_t index = (t % 2 == 0) ? i : stringCount - 1 - i;
+				results[t].emplace_back("concurrent_" + to_string(index));
+			}
+		});
+	for (auto& th: threads)
+		th.join();
+
+	for (size_t t = 0; t < threadCount; ++t)
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			size_t index = (t % 2 == 0) ? i : stringCount - 1 - i;
+			YulString const& s = results[t][i];
+			BOOST_CHECK_EQUAL(s.str(), "concurrent_" + to_string(index));
+			BOOST_CHECK(s == results[0][index]);
+		}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -0,0 +1,351 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Compile-time benchmark driver.
+ * Compiles the given inputs repeatedly and reports the time spent in the
+ * individual compiler phases as JSON.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/Version.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/YulString.h>
+
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+#include <libdevcore/Profiler.h>
+
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace langutil;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// The phases reported for each benchmark, in milliseconds.
+vector<string> const c_phases{"parsing", "analysis", "codegen", "legacyOptimizer", "yulOptimizer", "total"};
+
+using Timings = map<string, double>;
+
+double millisecondsSince(chrono::steady_clock::time_point _start)
+{
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - _start).count();
+}
+
+double profiledMilliseconds(Json::Value const& _report, string const& _phase)
+{
+	Json::Value const& phase = _report["phases"][_phase];
+	return phase.isObject() ? phase["wallTimeMs"].asDouble() : 0.0;
+}
+
+void printErrors(ErrorList const& _errors)
+{
+	SourceReferenceFormatter formatter(cerr);
+	for (auto const& error: _errors)
+		formatter.printErrorInformation(*error);
+}
+
+class Benchmark
+{
+public:
+	Benchmark(EVMVersion _evmVersion, OptimiserSettings _optimiserSettings, bool _astArena):
+		m_evmVersion(_evmVersion), m_optimiserSettings(move(_optimiserSettings)), m_astArena(_astArena)
+	{}
+
+	/// Compiles all Solidity files found at the given path (recursively if it is a directory)
+	/// as one compilation unit.
+	/// @returns false if compilation failed.
+	bool runSolidity(fs::path const& _path, Timings& _timings) const
+	{
+		fs::path const root = fs::is_directory(_path) ? _path : _path.parent_path();
+		StringMap sources;
+		if (fs::is_directory(_path))
+		{
+			for (auto const& entry: fs::recursive_directory_iterator(_path))
+				if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+					sources[fs::relative(entry.path(), root).generic_string()] = readFileAsString(entry.path().string());
+		}
+		else
+			sources[_path.filename().generic_string()] = readFileAsString(_path.string());
+
+		ReadCallback::Callback fileReader = [&](string const& _sourcePath)
+		{
+			fs::path path = root / _sourcePath;
+			if (!fs::is_regular_file(path))
+				return ReadCallback::Result{false, "File not found."};
+			return ReadCallback::Result{true, readFileAsString(path.string())};
+		};
+
+		CompilerStack compiler(fileReader);
+		compiler.setEVMVersion(m_evmVersion);
+		compiler.setOptimiserSettings(m_optimiserSettings);
+		compiler.setASTArena(m_astArena);
+		compiler.setSources(move(sources));
+
+		auto start = chrono::steady_clock::now();
+		bool success = compiler.parse();
+		_timings["parsing"] = millisecondsSince(start);
+
+		if (success)
+		{
+			auto analysisStart = chrono::steady_clock::now();
+			success = compiler.analyze();
+			_timings["analysis"] = millisecondsSince(analysisStart);
+		}
+
+		if (success)
+		{
+			auto compilationStart = chrono::steady_clock::now();
+			success = compiler.compile();
+			_timings["codegen"] = millisecondsSince(compilationStart);
+		}
+		_timings["total"] = millisecondsSince(start);
+
+		if (!success)
+			printErrors(compiler.errors());
+		return success;
+	}
+
+	/// Optimises and assembles the given Yul object.
+	/// @returns false if compilation failed.
+	bool runYul(fs::path const& _path, Timings& _timings) const
+	{
+		yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+
+		auto start = chrono::steady_clock::now();
+		if (!stack.parseAndAnalyze(_path.filename().string(), readFileAsString(_path.string())))
+		{
+			printErrors(stack.errors());
+			return false;
+		}
+		_timings["parsing"] = millisecondsSince(start);
+
+		auto optimisationStart = chrono::steady_clock::now();
+		stack.optimize();
+		_timings["codegen"] = millisecondsSince(optimisationStart);
+
+		auto assemblyStart = chrono::steady_clock::now();
+		stack.assemble(yul::AssemblyStack::Machine::EVM);
+		_timings["codegen"] += millisecondsSince(assemblyStart);
+		_timings["total"] = millisecondsSince(start);
+		return true;
+	}
+
+	/// Runs the benchmark for the given path once.
+	/// @returns false if compilation failed.
+	bool run(fs::path const& _path, Timings& _timings) const
+	{
+		yul::YulStringRepository::reset();
+		Profiler& profiler = Profiler::instance();
+		profiler.reset();
+		profiler.setEnabled(true);
+		bool success =
+			_path.extension() == ".yul" ?
+			runYul(_path, _timings) :
+			runSolidity(_path, _timings);
+		profiler.setEnabled(false);
+
+		// The optimisers run as part of the code generation.
+		Json::Value report = profiler.report();
+		_timings["legacyOptimizer"] = profiledMilliseconds(report, "Assembly::optimise");
+		_timings["yulOptimizer"] = profiledMilliseconds(report, "OptimiserSuite");
+		_timings["codegen"] -= _timings["legacyOptimizer"] + _timings["yulOptimizer"];
+		return success;
+	}
+
+private:
+	EVMVersion m_evmVersion;
+	OptimiserSettings m_optimiserSettings;
+	bool m_astArena = false;
+};
+
+Json::Value statistics(vector<Timings> const& _runs)
+{
+	Json::Value result{Json::objectValue};
+	for (string const& phase: c_phases)
+	{
+		double mean = 0;
+		for (Timings const& run: _runs)
+			mean += run.count(phase) ? run.at(phase) : 0.0;
+		mean /= double(_runs.size());
+
+		double variance = 0;
+		for (Timings const& run: _runs)
+		{
+			double delta = (run.count(phase) ? run.at(phase) : 0.0) - mean;
+			variance += delta * delta;
+		}
+		if (_runs.size() > 1)
+			variance /= double(_runs.size() - 1);
+
+		result[phase]["mean"] = mean;
+		result[phase]["variance"] = variance;
+	}
+	return result;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(solbench, the compile-time benchmark driver.
+Usage: solbench [Options] <path>...
+Compiles each given path repeatedly and prints the mean and variance of the time
+(in milliseconds) spent in the individual compiler phases as JSON.
+A path can be a Solidity file, a Yul object (*.yul) or a directory, in which case
+all Solidity files in it are compiled together.
+The reported peak memory is the peak of the process up to the end of the benchmark,
+so run a single benchmark per process to get the peak memory of an individual input.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		(
+			"repetitions,n",
+			po::value<unsigned>()->default_value(5),
+			"Number of times each input is compiled."
+		)
+		(
+			"no-optimize",
+			"Disable the legacy and the Yul optimizer."
+		)
+		(
+			"ast-arena",
+			"Allocate the AST nodes from an arena."
+		)
+		(
+			"evm-version",
+			po::value<string>()->value_name("version"),
+			"Select desired EVM version."
+		)
+		("input-file", po::value<vector<string>>(), "input file");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	EVMVersion evmVersion;
+	if (arguments.count("evm-version"))
+	{
+		string versionString = arguments["evm-version"].as<string>();
+		std::optional<EVMVersion> version = EVMVersion::fromString(versionString);
+		if (!version)
+		{
+			cerr << "Invalid EVM version: " << versionString << endl;
+			return 1;
+		}
+		evmVersion = *version;
+	}
+
+	unsigned repetitions = arguments["repetitions"].as<unsigned>();
+	if (repetitions == 0)
+	{
+		cerr << "The number of repetitions has to be positive." << endl;
+		return 1;
+	}
+
+	Benchmark benchmark(
+		evmVersion,
+		arguments.count("no-optimize") ? OptimiserSettings::minimal() : OptimiserSettings::full(),
+		arguments.count("ast-arena") > 0
+	);
+
+	Json::Value output{Json::objectValue};
+	output["version"] = VersionString;
+	output["repetitions"] = repetitions;
+	output["optimize"] = !arguments.count("no-optimize");
+	output["astArena"] = arguments.count("ast-arena") > 0;
+	output["benchmarks"] = Json::objectValue;
+	for (string const& path: arguments["input-file"].as<vector<string>>())
+	{
+		if (!fs::exists(path))
+		{
+			cerr << "Input not found: " << path << endl;
+			return 1;
+		}
+
+		vector<Timings> runs(repetitions);
+		for (Timings& timings: runs)
+		{
+			bool success = false;
+			try
+			{
+				success = benchmark.run(path, timings);
+			}
+			catch (boost::exception const& _exception)
+			{
+				cerr << boost::diagnostic_information(_exception) << endl;
+			}
+			catch (std::exception const& _exception)
+			{
+				cerr << _exception.what() << endl;
+			}
+			if (!success)
+			{
+				cerr << "Compilation of " << path << " failed." << endl;
+				return 1;
+			}
+		}
+
+		Json::Value& result = output["benchmarks"][path];
+		result["phases"] = statistics(runs);
+		if (uint64_t peakRSS = Profiler::peakResidentSetSize())
+			result["peakRSSKb"] = Json::UInt64(peakRSS);
+	}
+
+	cout << jsonPrettyPrint(output) << endl;
+	return 0;
+}
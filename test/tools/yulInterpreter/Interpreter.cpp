@@ -239,6 +239,12 @@ void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
 
 	solAssert(fun, "Function not found.");
 	solAssert(m_values.size() == fun->parameters.size(), "");
+	if (_funCall.location.source && _funCall.location.start >= 0)
+		m_state.callSiteCounts[{
+			_funCall.location.source->name(),
+			_funCall.location.start,
+			_funCall.location.end
+		}]++;
 	map<YulString, u256> variables;
 	for (size_t i = 0; i < fun->parameters.size(); ++i)
 		variables[fun->parameters.at(i).name] = m_values.at(i);
@@ -22,6 +22,7 @@
 
 #include <libyul/AsmDataForward.h>
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/CallSiteProfile.h>
 
 #include <libdevcore/FixedHash.h>
 #include <libdevcore/CommonData.h>
@@ -85,6 +86,8 @@ struct InterpreterState
 	dev::u256 chainid = 0x01;
 	/// Log of changes / effects. Sholud be structured data in the future.
 	std::vector<std::string> trace;
+	/// Number of executions of calls to user-defined functions.
+	CallSiteCounts callSiteCounts;
 	/// This is actually an input parameter that more or less limits the runtime.
 	size_t maxTraceSize = 0;
 	size_t maxSteps = 0;
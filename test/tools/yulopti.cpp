@@ -58,6 +58,7 @@
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
+#include <libyul/optimiser/Suite.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/VarNameCleaner.h>
@@ -141,91 +142,16 @@ public:
 			cout << "  (r)edundant assign elim./re(m)aterializer/f(o)r-loop-init-rewriter/for-loop-condition-(I)nto-body/" << endl;
 			cout << "  for-loop-condition-(O)ut-of-body/s(t)ructural simplifier/equi(v)alent function combiner/ssa re(V)erser/" << endl;
 			cout << "  co(n)trol flow simplifier/stack com(p)ressor/(D)ead code eliminator/(L)oad resolver/ " << endl;
-			cout << "  (C)onditional simplifier?" << endl;
+			cout << "  (C)onditional simplifier/conditional (U)nsimplifier?" << endl;
 			cout.flush();
 			int option = readStandardInputChar();
 			cout << ' ' << char(option) << endl;
 
-			OptimiserStepContext context{m_dialect, *m_nameDispenser, reservedIdentifiers};
+			OptimiserStepContext context{m_dialect, *m_nameDispenser, reservedIdentifiers, nullptr};
 			switch (option)
 			{
 			case 'q':
 				return;
-			case 'f':
-				BlockFlattener::run(context, *m_ast);
-				break;
-			case 'o':
-				ForLoopInitRewriter::run(context, *m_ast);
-				break;
-			case 'O':
-				ForLoopConditionOutOfBody::run(context, *m_ast);
-				break;
-			case 'I':
-				ForLoopConditionIntoBody::run(context, *m_ast);
-				break;
-			case 'c':
-				CommonSubexpressionEliminator::run(context, *m_ast);
-				break;
-			case 'C':
-				ConditionalSimplifier::run(context, *m_ast);
-				break;
-			case 'd':
-				VarDeclInitializer::run(context, *m_ast);
-				break;
-			case 'l':
-				VarNameCleaner::run(context, *m_ast);
-				break;
-			case 'x':
-				ExpressionSplitter::run(context, *m_ast);
-				break;
-			case 'j':
-				ExpressionJoiner::run(context, *m_ast);
-				break;
-			case 'g':
-				FunctionGrouper::run(context, *m_ast);
-				break;
-			case 'h':
-				FunctionHoister::run(context, *m_ast);
-				break;
-			case 'e':
-				ExpressionInliner::run(context, *m_ast);
-				break;
-			case 'i':
-				FullInliner::run(context, *m_ast);
-				break;
-			case 's':
-				ExpressionSimplifier::run(context, *m_ast);
-				break;
-			case 't':
-				StructuralSimplifier::run(context, *m_ast);
-				break;
-			case 'T':
-				LiteralRematerialiser::run(context, *m_ast);
-				break;
-			case 'n':
-				ControlFlowSimplifier::run(context, *m_ast);
-				break;
-			case 'u':
-				UnusedPruner::run(context, *m_ast);
-				break;
-			case 'D':
-				DeadCodeEliminator::run(context, *m_ast);
-				break;
-			case 'a':
-				SSATransform::run(context, *m_ast);
-				break;
-			case 'r':
-				RedundantAssignEliminator::run(context, *m_ast);
-				break;
-			case 'm':
-				Rematerialiser::run(context, *m_ast);
-				break;
-			case 'v':
-				EquivalentFunctionCombiner::run(context, *m_ast);
-				break;
-			case 'V':
-				SSAReverser::run(context, *m_ast);
-				break;
 			case 'p':
 			{
 				Object obj;
@@ -233,11 +159,16 @@ public:
 				StackCompressor::run(m_dialect, obj, true, 16);
 				break;
 			}
-			case 'L':
-				LoadResolver::run(context, *m_ast);
+			case 'l':
+				VarNameCleaner::run(context, *m_ast);
 				break;
 			default:
-				cout << "Unknown option." << endl;
+				if (OptimiserSuite::stepAbbreviationToNameMap().count(char(option)))
+					OptimiserSuite::allSteps().at(
+						OptimiserSuite::stepAbbreviationToNameMap().at(char(option))
+					)->run(context, *m_ast);
+				else
+					cout << "Unknown option." << endl;
 			}
 			source = AsmPrinter{}(*m_ast);
 		}
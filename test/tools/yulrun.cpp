@@ -34,12 +34,15 @@
 
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/CommonData.h>
+#include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
 
 #include <boost/program_options.hpp>
 
 #include <string>
 #include <memory>
 #include <iostream>
+#include <fstream>
 
 using namespace std;
 using namespace langutil;
@@ -58,14 +61,14 @@ void printErrors(ErrorList const& _errors)
 		SourceReferenceFormatter(cout).printErrorInformation(*error);
 }
 
-pair<shared_ptr<Block>, shared_ptr<AsmAnalysisInfo>> parse(string const& _source)
+pair<shared_ptr<Block>, shared_ptr<AsmAnalysisInfo>> parse(string const& _sourceName, string const& _source)
 {
 	AssemblyStack stack(
 		langutil::EVMVersion(),
 		AssemblyStack::Language::StrictAssembly,
 		solidity::OptimiserSettings::none()
 	);
-	if (stack.parseAndAnalyze("--INPUT--", _source))
+	if (stack.parseAndAnalyze(_sourceName, _source))
 	{
 		yulAssert(stack.errors().empty(), "Parsed successfully but had errors.");
 		return make_pair(stack.parserResult()->code, stack.parserResult()->analysisInfo);
@@ -77,13 +80,13 @@ pair<shared_ptr<Block>, shared_ptr<AsmAnalysisInfo>> parse(string const& _source
 	}
 }
 
-void interpret(string const& _source)
+bool interpret(string const& _sourceName, string const& _source, string const& _profileFile)
 {
 	shared_ptr<Block> ast;
 	shared_ptr<AsmAnalysisInfo> analysisInfo;
-	tie(ast, analysisInfo) = parse(_source);
+	tie(ast, analysisInfo) = parse(_sourceName, _source);
 	if (!ast || !analysisInfo)
-		return;
+		return true;
 
 	InterpreterState state;
 	state.maxTraceSize = 10000;
@@ -98,6 +101,21 @@ void interpret(string const& _source)
 	}
 
 	state.dumpTraceAndState(cout);
+
+	if (!_profileFile.empty())
+	{
+		CallSiteProfile profile;
+		profile.sourceHashes[_sourceName] = keccak256(_source);
+		profile.counts = move(state.callSiteCounts);
+		ofstream profileStream(_profileFile, ios::trunc);
+		profileStream << jsonPrettyPrint(callSiteProfileToJson(profile)) << endl;
+		if (!profileStream)
+		{
+			cerr << "Could not write profile to \"" << _profileFile << "\"." << endl;
+			return false;
+		}
+	}
+	return true;
 }
 
 }
@@ -114,6 +132,12 @@ Allowed options)",
 		po::options_description::m_default_line_length - 23);
 	options.add_options()
 		("help", "Show this help screen.")
+		(
+			"profile",
+			po::value<string>()->value_name("file"),
+			"Write the number of executions of each function call to the given file, "
+			"to be used with solc --yul-profile."
+		)
 		("input-file", po::value<vector<string>>(), "input file");
 	po::positional_options_description filesPositions;
 	filesPositions.add("input-file", -1);
@@ -135,15 +159,25 @@ Allowed options)",
 		cout << options;
 	else
 	{
+		string sourceName = "<stdin>";
 		string input;
 
 		if (arguments.count("input-file"))
-			for (string path: arguments["input-file"].as<vector<string>>())
+		{
+			vector<string> paths = arguments["input-file"].as<vector<string>>();
+			// The profile refers to the source by the name solc uses for the input file.
+			if (paths.size() == 1)
+				sourceName = paths.front();
+			else
+				sourceName = "--INPUT--";
+			for (string path: paths)
 				input += readFileAsString(path);
+		}
 		else
 			input = readStandardInput();
 
-		interpret(input);
+		if (!interpret(sourceName, input, arguments.count("profile") ? arguments["profile"].as<string>() : string{}))
+			return 1;
 	}
 
 	return 0;